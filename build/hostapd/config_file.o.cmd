@@ -0,0 +1 @@
+/root/repo/hostapd: cc -c -o /root/repo/build/hostapd/config_file.o -MMD -O2 -Wall -g -DTNC_CONFIG_FILE=\"tnc/tnc_config\" -DALL_DH_GROUPS -DCONFIG_RADIUS_TEST  -I/root/repo/src -I/root/repo/src/utils -DCONFIG_TESTING_OPTIONS -DHOSTAPD -DCONFIG_TAXONOMY -DCONFIG_MODULE_TESTS -DHOSTAPD_DUMP_STATE -DCONFIG_FULL_DYNAMIC_VLAN -DCONFIG_CTRL_IFACE_UNIX -DCONFIG_CTRL_IFACE -DCONFIG_RSN_PREAUTH -DCONFIG_SUITEB -DCONFIG_SUITEB192 -DCONFIG_OCV -DCONFIG_IEEE80211R -DCONFIG_IEEE80211R_AP -DCONFIG_ETH_P_OUI -DCONFIG_SAE -DCONFIG_SAE_PK -DCONFIG_OWE -DCONFIG_AIRTIME_POLICY -DCONFIG_FILS -DCONFIG_FILS_SK_PFS -DCONFIG_WNM -DCONFIG_WNM_AP -DCONFIG_IEEE80211AC -DCONFIG_IEEE80211BE -DCONFIG_IEEE80211AX -DCONFIG_MBO -DCONFIG_DRIVER_MACSEC_LINUX -DCONFIG_DRIVER_NL80211 -DCONFIG_DRIVER_NONE -I/usr/include/libnl3  -DCONFIG_LIBNL3_ROUTE -DCONFIG_ERP -DEAP_SERVER_MD5 -DEAP_SERVER_TLS -DEAP_SERVER_UNAUTH_TLS -DEAP_SERVER_PEAP -DEAP_SERVER_TTLS -DEAP_SERVER_MSCHAPV2 -DEAP_SERVER_GTC -DEAP_SERVER_SIM -DEAP_SERVER_AKA -DEAP_SERVER_AKA_PRIME -DEAP_SERVER_PAX -DEAP_SERVER_PSK -DEAP_SERVER_SAKE -DEAP_SERVER_GPSK -DEAP_GPSK_SHA256 -DEAP_SERVER_PWD -DEAP_SERVER_EKE -DEAP_SERVER_VENDOR_TEST -DEAP_SERVER_FAST -DEAP_SERVER_TEAP -DCONFIG_WPS -DEAP_SERVER_WSC -DCONFIG_WPS_NFC -DCONFIG_WPS_OOB -DCONFIG_WPS_UPNP -DCONFIG_WPS_TESTING -DCONFIG_DPP -DCONFIG_DPP2 -DCONFIG_DPP3 -DCONFIG_PASN -DCONFIG_PTKSA_CACHE -DEAP_SERVER_IKEV2 -DEAP_SERVER_TNC -DCONFIG_MACSEC -DEAP_SERVER_IDENTITY -DEAP_SERVER -DPKCS12_FUNCS -DEAP_TLS_FUNCS -DCONFIG_TLSV11 -DCONFIG_TLSV12 -DCRYPTO_RSA_OAEP_SHA256 -DTLS_DEFAULT_CIPHERS=\""DEFAULT:!EXP:!LOW"\" -DCONFIG_DES -DCONFIG_SHA256 -DCONFIG_SHA384 -DCONFIG_SHA512 -DALL_DH_GROUPS -DCONFIG_ECC -DCONFIG_NO_RANDOM_POOL -DRADIUS_SERVER -DCONFIG_IPV6 -DCONFIG_JSON -DNEED_AP_MLME -DCONFIG_P2P_MANAGER -DCONFIG_HS20 -DCONFIG_INTERWORKING -DCONFIG_PROXYARP -DCONFIG_ACS -DCONFIG_DEBUG_LINUX_TRACING -DCONFIG_DEBUG_FILE -DCONFIG_SQLITE -DCONFIG_FST -DCONFIG_FST_TEST -DCONFIG_WEP config_file.c
@@ -0,0 +1 @@
+/root/repo/src/common: cc -c -o /root/repo/build/tests/src/common/gas.o -DCONFIG_IEEE80211R -DCONFIG_HS20 -DCONFIG_SAE -DCONFIG_SUITE -DCONFIG_SUITEB -DCONFIG_PTKSA_CACHE  -I.. -I../utils gas.c
@@ -0,0 +1 @@
+/root/repo/src/common: cc -c -o /root/repo/build/tests/src/common/ieee802_11_common.o -DCONFIG_IEEE80211R -DCONFIG_HS20 -DCONFIG_SAE -DCONFIG_SUITE -DCONFIG_SUITEB -DCONFIG_PTKSA_CACHE  -I.. -I../utils ieee802_11_common.c
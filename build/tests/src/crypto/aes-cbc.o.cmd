@@ -0,0 +1 @@
+/root/repo/src/crypto: cc -c -o /root/repo/build/tests/src/crypto/aes-cbc.o -DCONFIG_CRYPTO_INTERNAL -DCONFIG_TLS_INTERNAL_CLIENT -DCONFIG_TLS_INTERNAL_SERVER -DCONFIG_SHA256 -DCONFIG_SHA384 -DCONFIG_HMAC_SHA384_KDF -DCONFIG_INTERNAL_SHA384  -I.. -I../utils aes-cbc.c
@@ -0,0 +1 @@
+/root/repo/tests: cc -c -o /root/repo/build/tests/src/rsn_supp/pmksa_cache.o -MMD -O2 -Wall -g -DCONFIG_IEEE80211R_AP -DCONFIG_IEEE80211R -DCONFIG_TDLS -I../src -I../src/utils -I../src -I../src/utils -I../wpa_supplicant -DCONFIG_DRIVER_NONE -DIEEE8021X_EAPOL ../src/rsn_supp/pmksa_cache.c
@@ -0,0 +1 @@
+/root/repo/src/tls: cc -c -o /root/repo/build/tests/src/tls/bignum.o -DCONFIG_INTERNAL_LIBTOMMATH -DCONFIG_CRYPTO_INTERNAL -DCONFIG_TLSV11 -DCONFIG_TLSV12  -I.. -I../utils bignum.c
@@ -0,0 +1 @@
+/root/repo/src/utils: cc -c -o /root/repo/build/tests/src/utils/eloop.o -DCONFIG_IPV6 -DCONFIG_DEBUG_FILE  -I.. -I../utils eloop.c
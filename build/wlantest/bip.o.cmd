@@ -0,0 +1 @@
+/root/repo/wlantest: cc -c -o /root/repo/build/wlantest/bip.o -MMD -O2 -Wall -g -I/tmp/fakepcap -I. -I../src -I../src/utils -DCONFIG_OCV -DCONFIG_IEEE80211R -DCONFIG_HS20 -DCONFIG_DEBUG_FILE -DCONFIG_FILS -DCONFIG_SAE -DCONFIG_OWE -DCONFIG_DPP -DCONFIG_SHA384 -DCONFIG_SHA512 -DCONFIG_PASN bip.c
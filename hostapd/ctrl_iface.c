@@ -5105,6 +5105,28 @@ static void hostapd_ctrl_iface_msg_cb(void *ctx, int level,
 }
 
 
+static int hostapd_ctrl_iface_msg_check(void *ctx, int level,
+					enum wpa_msg_type type)
+{
+	struct hostapd_data *hapd = ctx;
+
+	if (hapd == NULL)
+		return 0;
+
+	if (type != WPA_MSG_NO_GLOBAL &&
+	    hapd->iface->interfaces->global_ctrl_sock >= 0 &&
+	    ctrl_iface_monitored(&hapd->iface->interfaces->global_ctrl_dst,
+				 level))
+		return 1;
+
+	if (type != WPA_MSG_ONLY_GLOBAL && hapd->ctrl_sock >= 0 &&
+	    ctrl_iface_monitored(&hapd->ctrl_dst, level))
+		return 1;
+
+	return 0;
+}
+
+
 int hostapd_ctrl_iface_init(struct hostapd_data *hapd)
 {
 #ifdef CONFIG_CTRL_IFACE_UDP
@@ -5192,6 +5214,7 @@ try_again:
 
 	hapd->msg_ctx = hapd;
 	wpa_msg_register_cb(hostapd_ctrl_iface_msg_cb);
+	wpa_msg_register_check_cb(hostapd_ctrl_iface_msg_check);
 
 	return 0;
 
@@ -5345,6 +5368,7 @@ fail:
 	}
 	hapd->msg_ctx = hapd;
 	wpa_msg_register_cb(hostapd_ctrl_iface_msg_cb);
+	wpa_msg_register_check_cb(hostapd_ctrl_iface_msg_check);
 
 	return 0;
 
@@ -5997,6 +6021,7 @@ try_again:
 	}
 
 	wpa_msg_register_cb(hostapd_ctrl_iface_msg_cb);
+	wpa_msg_register_check_cb(hostapd_ctrl_iface_msg_check);
 
 	return 0;
 
@@ -6101,6 +6126,7 @@ fail:
 				 interface, NULL);
 
 	wpa_msg_register_cb(hostapd_ctrl_iface_msg_cb);
+	wpa_msg_register_check_cb(hostapd_ctrl_iface_msg_check);
 
 	return 0;
 
@@ -67,20 +67,28 @@ static int sqn_changes = 0;
 static int ind_len = 5;
 static int stdout_debug = 1;
 
+/* Number of hash buckets for the IMSI indexes (must be a power of two) */
+#define IMSI_HASH_SIZE 16384
+
 /* GSM triplets */
 struct gsm_triplet {
 	struct gsm_triplet *next;
+	struct gsm_triplet *hnext; /* next entry in the IMSI hash bucket */
 	char imsi[20];
 	u8 kc[8];
 	u8 sres[4];
 	u8 _rand[16];
 };
 
-static struct gsm_triplet *gsm_db = NULL, *gsm_db_pos = NULL;
+static struct gsm_triplet *gsm_db = NULL;
+static struct gsm_triplet *gsm_db_hash[IMSI_HASH_SIZE];
+static struct gsm_triplet *gsm_db_pos[IMSI_HASH_SIZE];
 
 /* OPc and AMF parameters for Milenage (Example algorithms for AKA). */
 struct milenage_parameters {
 	struct milenage_parameters *next;
+	struct milenage_parameters *hnext; /* next entry in the IMSI hash
+					    * bucket */
 	char imsi[20];
 	u8 ki[16];
 	u8 opc[16];
@@ -91,6 +99,7 @@ struct milenage_parameters {
 };
 
 static struct milenage_parameters *milenage_db = NULL;
+static struct milenage_parameters *milenage_db_hash[IMSI_HASH_SIZE];
 
 #define EAP_SIM_MAX_CHAL 3
 
@@ -106,6 +115,8 @@ static struct milenage_parameters *milenage_db = NULL;
 #ifdef CONFIG_SQLITE
 
 static sqlite3 *sqlite_db = NULL;
+static sqlite3_stmt *db_get_stmt = NULL;
+static sqlite3_stmt *db_update_sqn_stmt = NULL;
 static struct milenage_parameters db_tmp_milenage;
 
 
@@ -158,75 +169,82 @@ static sqlite3 * db_open(const char *db_file)
 		return NULL;
 	}
 
+	/* The same queries are used for every request, so prepare them only
+	 * once */
+	if (sqlite3_prepare_v2(db, "SELECT ki,opc,amf,sqn,res_len FROM "
+			       "milenage WHERE imsi=?;", -1, &db_get_stmt,
+			       NULL) != SQLITE_OK ||
+	    sqlite3_prepare_v2(db, "UPDATE milenage SET sqn=? WHERE imsi=?;",
+			       -1, &db_update_sqn_stmt, NULL) != SQLITE_OK) {
+		printf("Failed to prepare SQLite statements: %s\n",
+		       sqlite3_errmsg(db));
+		sqlite3_finalize(db_get_stmt);
+		db_get_stmt = NULL;
+		sqlite3_close(db);
+		return NULL;
+	}
+
 	return db;
 }
 
 
-static int get_milenage_cb(void *ctx, int argc, char *argv[], char *col[])
+static void db_close(void)
 {
-	struct milenage_parameters *m = ctx;
-	int i;
-
-	m->set = 1;
-
-	for (i = 0; i < argc; i++) {
-		if (os_strcmp(col[i], "ki") == 0 && argv[i] &&
-		    hexstr2bin(argv[i], m->ki, sizeof(m->ki))) {
-			printf("Invalid ki value in database\n");
-			return -1;
-		}
-
-		if (os_strcmp(col[i], "opc") == 0 && argv[i] &&
-		    hexstr2bin(argv[i], m->opc, sizeof(m->opc))) {
-			printf("Invalid opcvalue in database\n");
-			return -1;
-		}
+	sqlite3_finalize(db_get_stmt);
+	db_get_stmt = NULL;
+	sqlite3_finalize(db_update_sqn_stmt);
+	db_update_sqn_stmt = NULL;
+	sqlite3_close(sqlite_db);
+	sqlite_db = NULL;
+}
 
-		if (os_strcmp(col[i], "amf") == 0 && argv[i] &&
-		    hexstr2bin(argv[i], m->amf, sizeof(m->amf))) {
-			printf("Invalid amf value in database\n");
-			return -1;
-		}
 
-		if (os_strcmp(col[i], "sqn") == 0 && argv[i] &&
-		    hexstr2bin(argv[i], m->sqn, sizeof(m->sqn))) {
-			printf("Invalid sqn value in database\n");
-			return -1;
-		}
+static int db_get_hex(sqlite3_stmt *stmt, int col, u8 *buf, size_t len,
+		      const char *name)
+{
+	const char *val = (const char *) sqlite3_column_text(stmt, col);
 
-		if (os_strcmp(col[i], "res_len") == 0 && argv[i]) {
-			m->res_len = atoi(argv[i]);
-		}
+	if (val && hexstr2bin(val, buf, len)) {
+		printf("Invalid %s value in database\n", name);
+		return -1;
 	}
-
 	return 0;
 }
 
 
 static struct milenage_parameters * db_get_milenage(const char *imsi_txt)
 {
-	char cmd[128];
+	struct milenage_parameters *m = &db_tmp_milenage;
 	unsigned long long imsi;
+	int res;
 
-	os_memset(&db_tmp_milenage, 0, sizeof(db_tmp_milenage));
+	os_memset(m, 0, sizeof(*m));
 	imsi = atoll(imsi_txt);
-	os_snprintf(db_tmp_milenage.imsi, sizeof(db_tmp_milenage.imsi),
-		    "%llu", imsi);
-	os_snprintf(cmd, sizeof(cmd),
-		    "SELECT * FROM milenage WHERE imsi=%llu;", imsi);
-	if (sqlite3_exec(sqlite_db, cmd, get_milenage_cb, &db_tmp_milenage,
-			 NULL) != SQLITE_OK)
+	os_snprintf(m->imsi, sizeof(m->imsi), "%llu", imsi);
+
+	sqlite3_reset(db_get_stmt);
+	if (sqlite3_bind_int64(db_get_stmt, 1, imsi) != SQLITE_OK)
+		return NULL;
+	res = sqlite3_step(db_get_stmt);
+	if (res != SQLITE_ROW)
 		return NULL;
 
-	if (!db_tmp_milenage.set)
+	if (db_get_hex(db_get_stmt, 0, m->ki, sizeof(m->ki), "ki") ||
+	    db_get_hex(db_get_stmt, 1, m->opc, sizeof(m->opc), "opc") ||
+	    db_get_hex(db_get_stmt, 2, m->amf, sizeof(m->amf), "amf") ||
+	    db_get_hex(db_get_stmt, 3, m->sqn, sizeof(m->sqn), "sqn"))
 		return NULL;
-	return &db_tmp_milenage;
+	if (sqlite3_column_type(db_get_stmt, 4) != SQLITE_NULL)
+		m->res_len = sqlite3_column_int(db_get_stmt, 4);
+	m->set = 1;
+
+	return m;
 }
 
 
 static int db_update_milenage_sqn(struct milenage_parameters *m)
 {
-	char cmd[128], val[13], *pos;
+	char val[13], *pos;
 
 	if (sqlite_db == NULL)
 		return 0;
@@ -234,10 +252,12 @@ static int db_update_milenage_sqn(struct milenage_parameters *m)
 	pos = val;
 	pos += wpa_snprintf_hex(pos, sizeof(val), m->sqn, 6);
 	*pos = '\0';
-	os_snprintf(cmd, sizeof(cmd),
-		    "UPDATE milenage SET sqn='%s' WHERE imsi=%s;",
-		    val, m->imsi);
-	if (sqlite3_exec(sqlite_db, cmd, NULL, NULL, NULL) != SQLITE_OK) {
+	sqlite3_reset(db_update_sqn_stmt);
+	if (sqlite3_bind_text(db_update_sqn_stmt, 1, val, -1,
+			      SQLITE_TRANSIENT) != SQLITE_OK ||
+	    sqlite3_bind_int64(db_update_sqn_stmt, 2, atoll(m->imsi)) !=
+	    SQLITE_OK ||
+	    sqlite3_step(db_update_sqn_stmt) != SQLITE_DONE) {
 		printf("Failed to update SQN in database for IMSI %s\n",
 		       m->imsi);
 		return -1;
@@ -272,12 +292,24 @@ static int open_socket(const char *path)
 }
 
 
+static unsigned int imsi_hash(const char *imsi, size_t len)
+{
+	u32 hash = 5381;
+
+	while (len--)
+		hash = hash * 33 + (u8) *imsi++;
+
+	return hash & (IMSI_HASH_SIZE - 1);
+}
+
+
 static int read_gsm_triplets(const char *fname)
 {
 	FILE *f;
 	char buf[200], *pos, *pos2;
 	struct gsm_triplet *g = NULL;
 	int line, ret = 0;
+	unsigned int hash;
 
 	if (fname == NULL)
 		return -1;
@@ -349,6 +381,9 @@ static int read_gsm_triplets(const char *fname)
 
 		g->next = gsm_db;
 		gsm_db = g;
+		hash = imsi_hash(g->imsi, os_strlen(g->imsi));
+		g->hnext = gsm_db_hash[hash];
+		gsm_db_hash[hash] = g;
 		g = NULL;
 	}
 	os_free(g);
@@ -361,23 +396,26 @@ static int read_gsm_triplets(const char *fname)
 
 static struct gsm_triplet * get_gsm_triplet(const char *imsi)
 {
-	struct gsm_triplet *g = gsm_db_pos;
+	unsigned int hash = imsi_hash(imsi, os_strlen(imsi));
+	struct gsm_triplet *g = gsm_db_pos[hash];
 
+	/* Rotate through the triplets of the hash bucket starting from the
+	 * entry following the previously used one. */
 	while (g) {
 		if (strcmp(g->imsi, imsi) == 0) {
-			gsm_db_pos = g->next;
+			gsm_db_pos[hash] = g->hnext;
 			return g;
 		}
-		g = g->next;
+		g = g->hnext;
 	}
 
-	g = gsm_db;
-	while (g && g != gsm_db_pos) {
+	g = gsm_db_hash[hash];
+	while (g && g != gsm_db_pos[hash]) {
 		if (strcmp(g->imsi, imsi) == 0) {
-			gsm_db_pos = g->next;
+			gsm_db_pos[hash] = g->hnext;
 			return g;
 		}
-		g = g->next;
+		g = g->hnext;
 	}
 
 	return NULL;
@@ -390,6 +428,7 @@ static int read_milenage(const char *fname)
 	char buf[200], *pos, *pos2;
 	struct milenage_parameters *m = NULL;
 	int line, ret = 0;
+	unsigned int hash;
 
 	if (fname == NULL)
 		return -1;
@@ -483,6 +522,9 @@ static int read_milenage(const char *fname)
 
 		m->next = milenage_db;
 		milenage_db = m;
+		hash = imsi_hash(m->imsi, os_strlen(m->imsi));
+		m->hnext = milenage_db_hash[hash];
+		milenage_db_hash[hash] = m;
 		m = NULL;
 	}
 	os_free(m);
@@ -525,7 +567,8 @@ static void update_milenage_file(const char *fname)
 
 		imsi_len = pos - buf;
 
-		for (m = milenage_db; m; m = m->next) {
+		for (m = milenage_db_hash[imsi_hash(buf, imsi_len)]; m;
+		     m = m->hnext) {
 			if (strncmp(buf, m->imsi, imsi_len) == 0 &&
 			    m->imsi[imsi_len] == '\0')
 				break;
@@ -569,12 +612,13 @@ static void update_milenage_file(const char *fname)
 
 static struct milenage_parameters * get_milenage(const char *imsi)
 {
-	struct milenage_parameters *m = milenage_db;
+	struct milenage_parameters *m;
 
+	m = milenage_db_hash[imsi_hash(imsi, os_strlen(imsi))];
 	while (m) {
 		if (strcmp(m->imsi, imsi) == 0)
 			break;
-		m = m->next;
+		m = m->hnext;
 	}
 
 #ifdef CONFIG_SQLITE
@@ -954,10 +998,8 @@ static void cleanup(void)
 		unlink(socket_path);
 
 #ifdef CONFIG_SQLITE
-	if (sqlite_db) {
-		sqlite3_close(sqlite_db);
-		sqlite_db = NULL;
-	}
+	if (sqlite_db)
+		db_close();
 #endif /* CONFIG_SQLITE */
 }
 
@@ -1097,10 +1139,8 @@ int main(int argc, char *argv[])
 	}
 
 #ifdef CONFIG_SQLITE
-	if (sqlite_db) {
-		sqlite3_close(sqlite_db);
-		sqlite_db = NULL;
-	}
+	if (sqlite_db)
+		db_close();
 #endif /* CONFIG_SQLITE */
 
 	os_program_deinit();
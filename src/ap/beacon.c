@@ -1404,6 +1404,12 @@ void handle_probe_req(struct hostapd_data *hapd,
 		      int ssi_signal)
 {
 	struct ieee802_11_elems elems;
+	/* Elements used for processing Probe Request frames */
+	static const u8 ids[] = {
+		WLAN_EID_SSID, WLAN_EID_SUPP_RATES, WLAN_EID_EXT_SUPP_RATES,
+		WLAN_EID_DS_PARAMS, WLAN_EID_SSID_LIST, WLAN_EID_INTERWORKING,
+		WLAN_EID_VENDOR_SPECIFIC, WLAN_EID_EXTENSION,
+	};
 	const u8 *ie;
 	size_t ie_len;
 	size_t i;
@@ -1448,7 +1454,8 @@ void handle_probe_req(struct hostapd_data *hapd,
 	if (!hapd->conf->send_probe_response)
 		return;
 
-	if (ieee802_11_parse_elems(ie, ie_len, &elems, 0) == ParseFailed) {
+	if (ieee802_11_parse_elems_ids(ie, ie_len, &elems, ids, ARRAY_SIZE(ids),
+				       0) == ParseFailed) {
 		wpa_printf(MSG_DEBUG, "Could not parse ProbeReq from " MACSTR,
 			   MAC2STR(mgmt->sa));
 		return;
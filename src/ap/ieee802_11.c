@@ -5994,6 +5994,12 @@ static void handle_beacon(struct hostapd_data *hapd,
 			  struct hostapd_frame_info *fi)
 {
 	struct ieee802_11_elems elems;
+	/* Elements used by ap_list_process_beacon() */
+	static const u8 ids[] = {
+		WLAN_EID_SUPP_RATES, WLAN_EID_EXT_SUPP_RATES,
+		WLAN_EID_ERP_INFO, WLAN_EID_DS_PARAMS,
+		WLAN_EID_HT_OPERATION, WLAN_EID_HT_CAP,
+	};
 
 	if (len < IEEE80211_HDRLEN + sizeof(mgmt->u.beacon)) {
 		wpa_printf(MSG_INFO, "handle_beacon - too short payload (len=%lu)",
@@ -6001,10 +6007,10 @@ static void handle_beacon(struct hostapd_data *hapd,
 		return;
 	}
 
-	(void) ieee802_11_parse_elems(mgmt->u.beacon.variable,
-				      len - (IEEE80211_HDRLEN +
-					     sizeof(mgmt->u.beacon)), &elems,
-				      0);
+	(void) ieee802_11_parse_elems_ids(mgmt->u.beacon.variable,
+					  len - (IEEE80211_HDRLEN +
+						 sizeof(mgmt->u.beacon)),
+					  &elems, ids, ARRAY_SIZE(ids), 0);
 
 	ap_list_process_beacon(hapd->iface, mgmt, &elems, fi);
 }
@@ -917,6 +917,23 @@ void ieee802_1x_encapsulate_radius(struct hostapd_data *hapd,
 #endif /* CONFIG_NO_RADIUS */
 
 
+static void ieee802_1x_set_eap_resp(struct eapol_state_machine *sm,
+				    const struct eap_hdr *eap, size_t len)
+{
+	struct wpabuf *resp = sm->eap_if->eapRespData;
+
+	/* Reuse the previous response buffer if the new response fits in it */
+	if (resp && wpabuf_size(resp) >= len) {
+		resp->used = 0;
+		wpabuf_put_data(resp, eap, len);
+		return;
+	}
+
+	wpabuf_free(resp);
+	sm->eap_if->eapRespData = wpabuf_alloc_copy(eap, len);
+}
+
+
 static void handle_eap_response(struct hostapd_data *hapd,
 				struct sta_info *sta, struct eap_hdr *eap,
 				size_t len)
@@ -944,8 +961,7 @@ static void handle_eap_response(struct hostapd_data *hapd,
 
 	sm->dot1xAuthEapolRespFramesRx++;
 
-	wpabuf_free(sm->eap_if->eapRespData);
-	sm->eap_if->eapRespData = wpabuf_alloc_copy(eap, len);
+	ieee802_1x_set_eap_resp(sm, eap, len);
 	sm->eapolEap = true;
 }
 
@@ -975,8 +991,7 @@ static void handle_eap_initiate(struct hostapd_data *hapd,
 		       eap->code, eap->identifier, be_to_host16(eap->length),
 		       type);
 
-	wpabuf_free(sm->eap_if->eapRespData);
-	sm->eap_if->eapRespData = wpabuf_alloc_copy(eap, len);
+	ieee802_1x_set_eap_resp(sm, eap, len);
 	sm->eapolEap = true;
 #endif /* CONFIG_ERP */
 }
@@ -1874,10 +1874,20 @@ void wpa_receive(struct wpa_authenticator *wpa_auth,
 		wpa_replay_counter_mark_invalid(sm->key_replay, NULL);
 	}
 
-	os_free(sm->last_rx_eapol_key);
-	sm->last_rx_eapol_key = os_memdup(data, data_len);
-	if (!sm->last_rx_eapol_key)
-		goto out;
+	/*
+	 * Reuse the buffer from the previous frame when the new one fits to
+	 * avoid an allocation for every received EAPOL-Key frame.
+	 */
+	if (data_len > sm->last_rx_eapol_key_size) {
+		os_free(sm->last_rx_eapol_key);
+		sm->last_rx_eapol_key_len = 0;
+		sm->last_rx_eapol_key_size = 0;
+		sm->last_rx_eapol_key = os_malloc(data_len);
+		if (!sm->last_rx_eapol_key)
+			goto out;
+		sm->last_rx_eapol_key_size = data_len;
+	}
+	os_memcpy(sm->last_rx_eapol_key, data, data_len);
 	sm->last_rx_eapol_key_len = data_len;
 
 	sm->rx_eapol_key_secure = !!(key_info & WPA_KEY_INFO_SECURE);
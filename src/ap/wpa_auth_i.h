@@ -80,6 +80,7 @@ struct wpa_state_machine {
 
 	u8 *last_rx_eapol_key; /* starting from IEEE 802.1X header */
 	size_t last_rx_eapol_key_len;
+	size_t last_rx_eapol_key_size; /* allocated size of last_rx_eapol_key */
 
 	unsigned int changed:1;
 	unsigned int in_step_loop:1;
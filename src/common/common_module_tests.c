@@ -106,6 +106,54 @@ static int ieee802_11_parse_tests(void)
 		}
 	}
 
+	for (i = 0; parse_tests[i].data; i++) {
+		const struct ieee802_11_parse_test_data *test;
+		struct ieee802_11_elems elems;
+		u8 ids[256];
+		int j;
+
+		/* Requesting all element IDs must match full parsing */
+		for (j = 0; j < 256; j++)
+			ids[j] = j;
+		test = &parse_tests[i];
+		if (ieee802_11_parse_elems_ids(test->data, test->len, &elems,
+					       ids, sizeof(ids), 1) !=
+		    test->result) {
+			wpa_printf(MSG_ERROR,
+				   "ieee802_11_parse_elems_ids test %d failed",
+				   i);
+			ret = -1;
+		}
+	}
+
+	do {
+		struct ieee802_11_elems elems;
+		const u8 ids[] = { WLAN_EID_SSID };
+		const u8 data[] = {
+			WLAN_EID_SSID, 2, 'a', 'b',
+			WLAN_EID_SUPP_RATES, 1, 0x02,
+			WLAN_EID_VENDOR_SPECIFIC, 5, 0x11, 0x22, 0x33, 0x44, 0x01
+		};
+
+		if (ieee802_11_parse_elems_ids(data, sizeof(data), &elems,
+					       ids, ARRAY_SIZE(ids), 1) !=
+		    ParseOK ||
+		    !elems.ssid || elems.ssid_len != 2 || elems.supp_rates) {
+			wpa_printf(MSG_ERROR,
+				   "ieee802_11_parse_elems_ids selection test failed");
+			ret = -1;
+		}
+
+		/* Framing of the elements that are not requested is checked */
+		if (ieee802_11_parse_elems_ids(data, sizeof(data) - 1, &elems,
+					       ids, ARRAY_SIZE(ids), 1) !=
+		    ParseFailed) {
+			wpa_printf(MSG_ERROR,
+				   "ieee802_11_parse_elems_ids framing test failed");
+			ret = -1;
+		}
+	} while (0);
+
 	if (ieee802_11_vendor_ie_concat((const u8 *) "\x00\x01", 2, 0) != NULL)
 	{
 		wpa_printf(MSG_ERROR,
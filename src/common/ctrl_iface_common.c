@@ -140,6 +140,25 @@ static int ctrl_set_events(struct wpa_ctrl_dst *dst, const char *input)
 }
 
 
+/**
+ * ctrl_iface_monitored - Check whether any monitor accepts a message level
+ * @ctrl_dst: List of attached monitors (struct wpa_ctrl_dst)
+ * @level: Priority level (MSG_*) of the message
+ * Returns: 1 if at least one attached monitor would receive the message
+ */
+int ctrl_iface_monitored(struct dl_list *ctrl_dst, int level)
+{
+	struct wpa_ctrl_dst *dst;
+
+	dl_list_for_each(dst, ctrl_dst, struct wpa_ctrl_dst, list) {
+		if (level >= dst->debug_level)
+			return 1;
+	}
+
+	return 0;
+}
+
+
 int ctrl_iface_attach(struct dl_list *ctrl_dst, struct sockaddr_storage *from,
 		      socklen_t fromlen, const char *input)
 {
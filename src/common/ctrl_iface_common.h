@@ -32,6 +32,7 @@ struct wpa_ctrl_dst {
 void sockaddr_print(int level, const char *msg, struct sockaddr_storage *sock,
 		    socklen_t socklen);
 
+int ctrl_iface_monitored(struct dl_list *ctrl_dst, int level);
 int ctrl_iface_attach(struct dl_list *ctrl_dst, struct sockaddr_storage *from,
 		       socklen_t fromlen, const char *input);
 int ctrl_iface_detach(struct dl_list *ctrl_dst, struct sockaddr_storage *from,
@@ -436,7 +436,7 @@ static int ieee802_11_parse_extension(const u8 *pos, size_t elen,
 
 static ParseRes __ieee802_11_parse_elems(const u8 *start, size_t len,
 					 struct ieee802_11_elems *elems,
-					 int show_errors)
+					 const u8 *filter, int show_errors)
 {
 	const struct element *elem;
 	int unknown = 0;
@@ -455,6 +455,14 @@ static ParseRes __ieee802_11_parse_elems(const u8 *start, size_t len,
 		}
 		elems->num_frag_elems = 0;
 
+		/*
+		 * Elements that were not requested are only checked for valid
+		 * framing. MIC is always processed since it ends parsing.
+		 */
+		if (filter && id != WLAN_EID_MIC &&
+		    !(filter[id / 8] & BIT(id % 8)))
+			continue;
+
 		switch (id) {
 		case WLAN_EID_SSID:
 			if (elen > SSID_MAX_LEN) {
@@ -721,7 +729,40 @@ ParseRes ieee802_11_parse_elems(const u8 *start, size_t len,
 {
 	os_memset(elems, 0, sizeof(*elems));
 
-	return __ieee802_11_parse_elems(start, len, elems, show_errors);
+	return __ieee802_11_parse_elems(start, len, elems, NULL, show_errors);
+}
+
+
+/**
+ * ieee802_11_parse_elems_ids - Parse selected information elements
+ * @start: Pointer to the start of IEs
+ * @len: Length of IE buffer in octets
+ * @elems: Data structure for parsed elements
+ * @ids: Array of element IDs to parse
+ * @num: The number of entries in the array
+ * @show_errors: Whether to show parsing errors in debug log
+ * Returns: Parsing result
+ *
+ * This is like ieee802_11_parse_elems(), but only the elements with the listed
+ * element IDs are processed and all other fields in @elems are left cleared.
+ * The full IE buffer is still validated. Use WLAN_EID_VENDOR_SPECIFIC and
+ * WLAN_EID_EXTENSION to request vendor specific and extended elements.
+ */
+ParseRes ieee802_11_parse_elems_ids(const u8 *start, size_t len,
+				    struct ieee802_11_elems *elems,
+				    const u8 *ids, size_t num, int show_errors)
+{
+	u8 filter[256 / 8];
+	size_t i;
+
+	os_memset(filter, 0, sizeof(filter));
+	for (i = 0; i < num; i++)
+		filter[ids[i] / 8] |= BIT(ids[i] % 8);
+
+	os_memset(elems, 0, sizeof(*elems));
+
+	return __ieee802_11_parse_elems(start, len, elems, filter,
+					show_errors);
 }
 
 
@@ -1122,7 +1163,8 @@ ParseRes ieee802_11_parse_link_assoc_req(struct ieee802_11_elems *elems,
 
 		if (sub_elem_len)
 			res = __ieee802_11_parse_elems(pos, sub_elem_len,
-						       elems, show_errors);
+						       elems, NULL,
+						       show_errors);
 		else
 			res = ParseOK;
 		break;
@@ -13,6 +13,17 @@
 #include "aes.h"
 #include "aes_wrap.h"
 
+/*
+ * Use PCLMULQDQ instruction for GHASH when supported by the CPU (run time
+ * check). This can be disabled with CONFIG_NO_AES_NI.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+	!defined(CONFIG_NO_AES_NI)
+#define GCM_PCLMUL
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+#endif
+
 static void inc32(u8 *block)
 {
 	u32 val;
@@ -61,33 +72,116 @@ static void shift_right_block(u8 *v)
 }
 
 
+#ifdef GCM_PCLMUL
+
+static int gcm_pclmul_available(void)
+{
+	static int available = -1;
+
+	if (available < 0)
+		available = __builtin_cpu_supports("ssse3") &&
+			__builtin_cpu_supports("pclmul");
+	return available;
+}
+
+
+/*
+ * Multiplication in GF(2^128) using carry-less multiplication and the
+ * reduction from the Intel Carry-Less Multiplication Instruction and its Usage
+ * for Computing the GCM Mode white paper. The operands are byte reflected to
+ * match the bit order used in the white paper.
+ */
+__attribute__((target("ssse3,pclmul")))
+static void gf_mult_pclmul(const u8 *x, const u8 *y, u8 *z)
+{
+	const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+					   8, 9, 10, 11, 12, 13, 14, 15);
+	__m128i a, b, t2, t3, t4, t5, t6, t7, t8, t9;
+
+	a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) x), bswap);
+	b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) y), bswap);
+
+	/* 256-bit carry-less product <t6:t3> */
+	t3 = _mm_clmulepi64_si128(a, b, 0x00);
+	t4 = _mm_clmulepi64_si128(a, b, 0x10);
+	t5 = _mm_clmulepi64_si128(a, b, 0x01);
+	t6 = _mm_clmulepi64_si128(a, b, 0x11);
+	t4 = _mm_xor_si128(t4, t5);
+	t5 = _mm_slli_si128(t4, 8);
+	t4 = _mm_srli_si128(t4, 8);
+	t3 = _mm_xor_si128(t3, t5);
+	t6 = _mm_xor_si128(t6, t4);
+
+	/* Shift the product left by one bit due to the reflected bit order */
+	t7 = _mm_srli_epi32(t3, 31);
+	t8 = _mm_srli_epi32(t6, 31);
+	t3 = _mm_slli_epi32(t3, 1);
+	t6 = _mm_slli_epi32(t6, 1);
+	t9 = _mm_srli_si128(t7, 12);
+	t8 = _mm_slli_si128(t8, 4);
+	t7 = _mm_slli_si128(t7, 4);
+	t3 = _mm_or_si128(t3, t7);
+	t6 = _mm_or_si128(t6, t8);
+	t6 = _mm_or_si128(t6, t9);
+
+	/* Reduce modulo x^128 + x^7 + x^2 + x + 1 */
+	t7 = _mm_slli_epi32(t3, 31);
+	t8 = _mm_slli_epi32(t3, 30);
+	t9 = _mm_slli_epi32(t3, 25);
+	t7 = _mm_xor_si128(t7, t8);
+	t7 = _mm_xor_si128(t7, t9);
+	t8 = _mm_srli_si128(t7, 4);
+	t7 = _mm_slli_si128(t7, 12);
+	t3 = _mm_xor_si128(t3, t7);
+
+	t2 = _mm_srli_epi32(t3, 1);
+	t4 = _mm_srli_epi32(t3, 2);
+	t5 = _mm_srli_epi32(t3, 7);
+	t2 = _mm_xor_si128(t2, t4);
+	t2 = _mm_xor_si128(t2, t5);
+	t2 = _mm_xor_si128(t2, t8);
+	t3 = _mm_xor_si128(t3, t2);
+	t6 = _mm_xor_si128(t6, t3);
+
+	_mm_storeu_si128((__m128i *) z, _mm_shuffle_epi8(t6, bswap));
+}
+
+#endif /* GCM_PCLMUL */
+
+
 /* Multiplication in GF(2^128) */
 static void gf_mult(const u8 *x, const u8 *y, u8 *z)
 {
 	u8 v[16];
+	u32 *zw = (u32 *) z, *vw = (u32 *) v;
 	int i, j;
+	u32 m;
+
+#ifdef GCM_PCLMUL
+	if (gcm_pclmul_available()) {
+		gf_mult_pclmul(x, y, z);
+		return;
+	}
+#endif /* GCM_PCLMUL */
 
 	os_memset(z, 0, 16); /* Z_0 = 0^128 */
 	os_memcpy(v, y, 16); /* V_0 = Y */
 
+	/* Use masks instead of branches to avoid data dependent timing */
 	for (i = 0; i < 16; i++) {
 		for (j = 0; j < 8; j++) {
-			if (x[i] & BIT(7 - j)) {
-				/* Z_(i + 1) = Z_i XOR V_i */
-				xor_block(z, v);
-			} else {
-				/* Z_(i + 1) = Z_i */
-			}
-
-			if (v[15] & 0x01) {
-				/* V_(i + 1) = (V_i >> 1) XOR R */
-				shift_right_block(v);
-				/* R = 11100001 || 0^120 */
-				v[0] ^= 0xe1;
-			} else {
-				/* V_(i + 1) = V_i >> 1 */
-				shift_right_block(v);
-			}
+			/* Z_(i + 1) = Z_i XOR V_i if bit is set, else Z_i */
+			m = -(u32) ((x[i] >> (7 - j)) & 0x01);
+			zw[0] ^= vw[0] & m;
+			zw[1] ^= vw[1] & m;
+			zw[2] ^= vw[2] & m;
+			zw[3] ^= vw[3] & m;
+
+			/* V_(i + 1) = (V_i >> 1) XOR R if LSB of V_i is set,
+			 * else V_i >> 1; R = 11100001 || 0^120 */
+			m = -(u32) (v[15] & 0x01);
+			shift_right_block(v);
+			v[0] ^= 0xe1 & m;
 		}
 	}
 }
@@ -20,6 +20,10 @@
 #include "crypto.h"
 #include "aes_i.h"
 
+#ifdef AES_NI
+#include <wmmintrin.h>
+#endif /* AES_NI */
+
 static void rijndaelEncrypt(const u32 rk[], int Nr, const u8 pt[16], u8 ct[16])
 {
 	u32 s0, s1, s2, s3, t0, t1, t2, t3;
@@ -95,6 +99,55 @@ d##3 = TE0(s##3) ^ TE1(s##0) ^ TE2(s##1) ^ TE3(s##2) ^ rk[4 * i + 3]
 }
 
 
+#ifdef AES_NI
+
+static int aes_ni_available(void)
+{
+	static int available = -1;
+
+	if (available < 0)
+		available = __builtin_cpu_supports("sse2") &&
+			__builtin_cpu_supports("aes");
+	return available;
+}
+
+
+/*
+ * The round keys from rijndaelKeySetupEnc() are stored as big endian words.
+ * AES-NI uses the same key schedule as a byte array, so the words are
+ * converted into that format in place.
+ */
+static void aes_ni_convert_key(u32 rk[], int Nr)
+{
+	int i;
+	u32 val;
+
+	for (i = 0; i < 4 * (Nr + 1); i++) {
+		val = rk[i];
+		PUTU32((u8 *) &rk[i], val);
+	}
+}
+
+
+__attribute__((target("sse2,aes")))
+static void aes_ni_encrypt(const u32 rk[], int Nr, const u8 pt[16],
+			   u8 ct[16])
+{
+	const __m128i *k = (const __m128i *) rk;
+	__m128i s;
+	int r;
+
+	s = _mm_xor_si128(_mm_loadu_si128((const __m128i *) pt),
+			  _mm_loadu_si128(&k[0]));
+	for (r = 1; r < Nr; r++)
+		s = _mm_aesenc_si128(s, _mm_loadu_si128(&k[r]));
+	s = _mm_aesenclast_si128(s, _mm_loadu_si128(&k[Nr]));
+	_mm_storeu_si128((__m128i *) ct, s);
+}
+
+#endif /* AES_NI */
+
+
 void * aes_encrypt_init(const u8 *key, size_t len)
 {
 	u32 *rk;
@@ -112,6 +165,10 @@ void * aes_encrypt_init(const u8 *key, size_t len)
 		return NULL;
 	}
 	rk[AES_PRIV_NR_POS] = res;
+#ifdef AES_NI
+	if (aes_ni_available())
+		aes_ni_convert_key(rk, res);
+#endif /* AES_NI */
 	return rk;
 }
 
@@ -119,6 +176,12 @@ void * aes_encrypt_init(const u8 *key, size_t len)
 int aes_encrypt(void *ctx, const u8 *plain, u8 *crypt)
 {
 	u32 *rk = ctx;
+#ifdef AES_NI
+	if (aes_ni_available()) {
+		aes_ni_encrypt(rk, rk[AES_PRIV_NR_POS], plain, crypt);
+		return 0;
+	}
+#endif /* AES_NI */
 	rijndaelEncrypt(ctx, rk[AES_PRIV_NR_POS], plain, crypt);
 	return 0;
 }
@@ -14,6 +14,15 @@
 /* #define FULL_UNROLL */
 #define AES_SMALL_TABLES
 
+/*
+ * Use AES-NI instructions for encryption when supported by the CPU (run time
+ * check). This can be disabled with CONFIG_NO_AES_NI.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+	!defined(CONFIG_NO_AES_NI)
+#define AES_NI
+#endif
+
 extern const u32 Te0[256];
 extern const u32 Te1[256];
 extern const u32 Te2[256];
@@ -27,8 +27,15 @@
 #include "eap_server/eap_sim_db.h"
 #include "eloop.h"
 
+/*
+ * Number of hash buckets used for indexing pending queries, pseudonyms, and
+ * re-authentication entries (must be a power of two)
+ */
+#define EAP_SIM_DB_HASH_SIZE 256
+
 struct eap_sim_pseudonym {
-	struct eap_sim_pseudonym *next;
+	struct eap_sim_pseudonym *next; /* hash bucket by permanent */
+	struct eap_sim_pseudonym *id_next; /* hash bucket by pseudonym */
 	char *permanent; /* permanent username */
 	char *pseudonym; /* pseudonym username */
 };
@@ -63,9 +70,11 @@ struct eap_sim_db_data {
 	char *local_sock;
 	void (*get_complete_cb)(void *ctx, void *session_ctx);
 	void *ctx;
-	struct eap_sim_pseudonym *pseudonyms;
-	struct eap_sim_reauth *reauths;
-	struct eap_sim_db_pending *pending;
+	struct eap_sim_pseudonym *pseudonyms[EAP_SIM_DB_HASH_SIZE];
+	struct eap_sim_pseudonym *pseudonym_ids[EAP_SIM_DB_HASH_SIZE];
+	struct eap_sim_reauth *reauths[EAP_SIM_DB_HASH_SIZE];
+	struct eap_sim_reauth *reauth_ids[EAP_SIM_DB_HASH_SIZE];
+	struct eap_sim_db_pending *pending[EAP_SIM_DB_HASH_SIZE];
 	unsigned int eap_sim_db_timeout;
 #ifdef CONFIG_SQLITE
 	sqlite3 *sqlite_db;
@@ -81,6 +90,17 @@ static void eap_sim_db_del_timeout(void *eloop_ctx, void *user_ctx);
 static void eap_sim_db_query_timeout(void *eloop_ctx, void *user_ctx);
 
 
+static unsigned int eap_sim_db_hash(const char *str)
+{
+	u32 hash = 5381;
+
+	while (*str)
+		hash = hash * 33 + (u8) *str++;
+
+	return hash & (EAP_SIM_DB_HASH_SIZE - 1);
+}
+
+
 #ifdef CONFIG_SQLITE
 
 static int db_table_exists(sqlite3 *db, const char *name)
@@ -376,29 +396,28 @@ static void db_remove_reauth(struct eap_sim_db_data *data,
 static struct eap_sim_db_pending *
 eap_sim_db_get_pending(struct eap_sim_db_data *data, const char *imsi, int aka)
 {
-	struct eap_sim_db_pending *entry, *prev = NULL;
+	struct eap_sim_db_pending *entry, **pp;
 
-	entry = data->pending;
-	while (entry) {
+	pp = &data->pending[eap_sim_db_hash(imsi)];
+	while (*pp) {
+		entry = *pp;
 		if (entry->aka == aka && os_strcmp(entry->imsi, imsi) == 0) {
-			if (prev)
-				prev->next = entry->next;
-			else
-				data->pending = entry->next;
-			break;
+			*pp = entry->next;
+			return entry;
 		}
-		prev = entry;
-		entry = entry->next;
+		pp = &entry->next;
 	}
-	return entry;
+	return NULL;
 }
 
 
 static void eap_sim_db_add_pending(struct eap_sim_db_data *data,
 				   struct eap_sim_db_pending *entry)
 {
-	entry->next = data->pending;
-	data->pending = entry;
+	unsigned int hash = eap_sim_db_hash(entry->imsi);
+
+	entry->next = data->pending[hash];
+	data->pending[hash] = entry;
 }
 
 
@@ -414,7 +433,9 @@ static void eap_sim_db_free_pending(struct eap_sim_db_data *data,
 static void eap_sim_db_del_pending(struct eap_sim_db_data *data,
 				   struct eap_sim_db_pending *entry)
 {
-	struct eap_sim_db_pending **pp = &data->pending;
+	struct eap_sim_db_pending **pp;
+
+	pp = &data->pending[eap_sim_db_hash(entry->imsi)];
 
 	while (*pp != NULL) {
 		if (*pp == entry) {
@@ -825,6 +846,7 @@ void eap_sim_db_deinit(void *priv)
 	struct eap_sim_pseudonym *p, *prev;
 	struct eap_sim_reauth *r, *prevr;
 	struct eap_sim_db_pending *pending, *prev_pending;
+	unsigned int i;
 
 #ifdef CONFIG_SQLITE
 	if (data->sqlite_db) {
@@ -836,25 +858,27 @@ void eap_sim_db_deinit(void *priv)
 	eap_sim_db_close_socket(data);
 	os_free(data->fname);
 
-	p = data->pseudonyms;
-	while (p) {
-		prev = p;
-		p = p->next;
-		eap_sim_db_free_pseudonym(prev);
-	}
+	for (i = 0; i < EAP_SIM_DB_HASH_SIZE; i++) {
+		p = data->pseudonyms[i];
+		while (p) {
+			prev = p;
+			p = p->next;
+			eap_sim_db_free_pseudonym(prev);
+		}
 
-	r = data->reauths;
-	while (r) {
-		prevr = r;
-		r = r->next;
-		eap_sim_db_free_reauth(prevr);
-	}
+		r = data->reauths[i];
+		while (r) {
+			prevr = r;
+			r = r->next;
+			eap_sim_db_free_reauth(prevr);
+		}
 
-	pending = data->pending;
-	while (pending) {
-		prev_pending = pending;
-		pending = pending->next;
-		eap_sim_db_free_pending(data, prev_pending);
+		pending = data->pending[i];
+		while (pending) {
+			prev_pending = pending;
+			pending = pending->next;
+			eap_sim_db_free_pending(data, prev_pending);
+		}
 	}
 
 	os_free(data);
@@ -1107,10 +1131,38 @@ char * eap_sim_db_get_next_reauth_id(struct eap_sim_db_data *data,
  * This function adds a new pseudonym for EAP-SIM user. EAP-SIM DB is
  * responsible of freeing pseudonym buffer once it is not needed anymore.
  */
+static void eap_sim_db_unlink_pseudonym_id(struct eap_sim_db_data *data,
+					   struct eap_sim_pseudonym *p)
+{
+	struct eap_sim_pseudonym **pp;
+
+	pp = &data->pseudonym_ids[eap_sim_db_hash(p->pseudonym)];
+	while (*pp) {
+		if (*pp == p) {
+			*pp = p->id_next;
+			break;
+		}
+		pp = &(*pp)->id_next;
+	}
+}
+
+
+static void eap_sim_db_link_pseudonym_id(struct eap_sim_db_data *data,
+					 struct eap_sim_pseudonym *p)
+{
+	unsigned int hash = eap_sim_db_hash(p->pseudonym);
+
+	p->id_next = data->pseudonym_ids[hash];
+	data->pseudonym_ids[hash] = p;
+}
+
+
 int eap_sim_db_add_pseudonym(struct eap_sim_db_data *data,
 			     const char *permanent, char *pseudonym)
 {
 	struct eap_sim_pseudonym *p;
+	unsigned int hash;
+
 	wpa_printf(MSG_DEBUG, "EAP-SIM DB: Add pseudonym '%s' for permanent "
 		   "username '%s'", pseudonym, permanent);
 
@@ -1119,15 +1171,18 @@ int eap_sim_db_add_pseudonym(struct eap_sim_db_data *data,
 	if (data->sqlite_db)
 		return db_add_pseudonym(data, permanent, pseudonym);
 #endif /* CONFIG_SQLITE */
-	for (p = data->pseudonyms; p; p = p->next) {
+	hash = eap_sim_db_hash(permanent);
+	for (p = data->pseudonyms[hash]; p; p = p->next) {
 		if (os_strcmp(permanent, p->permanent) == 0)
 			break;
 	}
 	if (p) {
 		wpa_printf(MSG_DEBUG, "EAP-SIM DB: Replacing previous "
 			   "pseudonym: %s", p->pseudonym);
+		eap_sim_db_unlink_pseudonym_id(data, p);
 		os_free(p->pseudonym);
 		p->pseudonym = pseudonym;
+		eap_sim_db_link_pseudonym_id(data, p);
 		return 0;
 	}
 
@@ -1137,7 +1192,7 @@ int eap_sim_db_add_pseudonym(struct eap_sim_db_data *data,
 		return -1;
 	}
 
-	p->next = data->pseudonyms;
+	p->next = data->pseudonyms[hash];
 	p->permanent = os_strdup(permanent);
 	if (p->permanent == NULL) {
 		os_free(p);
@@ -1145,21 +1200,49 @@ int eap_sim_db_add_pseudonym(struct eap_sim_db_data *data,
 		return -1;
 	}
 	p->pseudonym = pseudonym;
-	data->pseudonyms = p;
+	data->pseudonyms[hash] = p;
+	eap_sim_db_link_pseudonym_id(data, p);
 
 	wpa_printf(MSG_DEBUG, "EAP-SIM DB: Added new pseudonym entry");
 	return 0;
 }
 
 
+static void eap_sim_db_unlink_reauth_id(struct eap_sim_db_data *data,
+					struct eap_sim_reauth *r)
+{
+	struct eap_sim_reauth **pp;
+
+	pp = &data->reauth_ids[eap_sim_db_hash(r->reauth_id)];
+	while (*pp) {
+		if (*pp == r) {
+			*pp = r->id_next;
+			break;
+		}
+		pp = &(*pp)->id_next;
+	}
+}
+
+
+static void eap_sim_db_link_reauth_id(struct eap_sim_db_data *data,
+				      struct eap_sim_reauth *r)
+{
+	unsigned int hash = eap_sim_db_hash(r->reauth_id);
+
+	r->id_next = data->reauth_ids[hash];
+	data->reauth_ids[hash] = r;
+}
+
+
 static struct eap_sim_reauth *
 eap_sim_db_add_reauth_data(struct eap_sim_db_data *data,
 			   const char *permanent,
 			   char *reauth_id, u16 counter)
 {
 	struct eap_sim_reauth *r;
+	unsigned int hash = eap_sim_db_hash(permanent);
 
-	for (r = data->reauths; r; r = r->next) {
+	for (r = data->reauths[hash]; r; r = r->next) {
 		if (os_strcmp(r->permanent, permanent) == 0)
 			break;
 	}
@@ -1167,8 +1250,10 @@ eap_sim_db_add_reauth_data(struct eap_sim_db_data *data,
 	if (r) {
 		wpa_printf(MSG_DEBUG, "EAP-SIM DB: Replacing previous "
 			   "reauth_id: %s", r->reauth_id);
+		eap_sim_db_unlink_reauth_id(data, r);
 		os_free(r->reauth_id);
 		r->reauth_id = reauth_id;
+		eap_sim_db_link_reauth_id(data, r);
 	} else {
 		r = os_zalloc(sizeof(*r));
 		if (r == NULL) {
@@ -1176,7 +1261,7 @@ eap_sim_db_add_reauth_data(struct eap_sim_db_data *data,
 			return NULL;
 		}
 
-		r->next = data->reauths;
+		r->next = data->reauths[hash];
 		r->permanent = os_strdup(permanent);
 		if (r->permanent == NULL) {
 			os_free(r);
@@ -1184,7 +1269,8 @@ eap_sim_db_add_reauth_data(struct eap_sim_db_data *data,
 			return NULL;
 		}
 		r->reauth_id = reauth_id;
-		data->reauths = r;
+		data->reauths[hash] = r;
+		eap_sim_db_link_reauth_id(data, r);
 		wpa_printf(MSG_DEBUG, "EAP-SIM DB: Added new reauth entry");
 	}
 
@@ -1295,11 +1381,11 @@ eap_sim_db_get_permanent(struct eap_sim_db_data *data, const char *pseudonym)
 		return db_get_pseudonym(data, pseudonym);
 #endif /* CONFIG_SQLITE */
 
-	p = data->pseudonyms;
+	p = data->pseudonym_ids[eap_sim_db_hash(pseudonym)];
 	while (p) {
 		if (os_strcmp(p->pseudonym, pseudonym) == 0)
 			return p->permanent;
-		p = p->next;
+		p = p->id_next;
 	}
 
 	return NULL;
@@ -1323,11 +1409,11 @@ eap_sim_db_get_reauth_entry(struct eap_sim_db_data *data,
 		return db_get_reauth(data, reauth_id);
 #endif /* CONFIG_SQLITE */
 
-	r = data->reauths;
+	r = data->reauth_ids[eap_sim_db_hash(reauth_id)];
 	while (r) {
 		if (os_strcmp(r->reauth_id, reauth_id) == 0)
 			break;
-		r = r->next;
+		r = r->id_next;
 	}
 
 	return r;
@@ -1343,25 +1429,22 @@ eap_sim_db_get_reauth_entry(struct eap_sim_db_data *data,
 void eap_sim_db_remove_reauth(struct eap_sim_db_data *data,
 			      struct eap_sim_reauth *reauth)
 {
-	struct eap_sim_reauth *r, *prev = NULL;
+	struct eap_sim_reauth **pp;
 #ifdef CONFIG_SQLITE
 	if (data->sqlite_db) {
 		db_remove_reauth(data, reauth);
 		return;
 	}
 #endif /* CONFIG_SQLITE */
-	r = data->reauths;
-	while (r) {
-		if (r == reauth) {
-			if (prev)
-				prev->next = r->next;
-			else
-				data->reauths = r->next;
-			eap_sim_db_free_reauth(r);
+	pp = &data->reauths[eap_sim_db_hash(reauth->permanent)];
+	while (*pp) {
+		if (*pp == reauth) {
+			*pp = reauth->next;
+			eap_sim_db_unlink_reauth_id(data, reauth);
+			eap_sim_db_free_reauth(reauth);
 			return;
 		}
-		prev = r;
-		r = r->next;
+		pp = &(*pp)->next;
 	}
 }
 
@@ -65,7 +65,8 @@ const char * eap_sim_db_get_permanent(struct eap_sim_db_data *data,
 				      const char *pseudonym);
 
 struct eap_sim_reauth {
-	struct eap_sim_reauth *next;
+	struct eap_sim_reauth *next; /* hash bucket by permanent */
+	struct eap_sim_reauth *id_next; /* hash bucket by reauth_id */
 	char *permanent; /* Permanent username */
 	char *reauth_id; /* Fast re-authentication username */
 	u16 counter;
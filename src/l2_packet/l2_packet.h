@@ -156,4 +156,35 @@ void l2_packet_notify_auth_start(struct l2_packet_data *l2);
 int l2_packet_set_packet_filter(struct l2_packet_data *l2,
 				enum l2_packet_filter_type type);
 
+/**
+ * struct l2_packet_stats - l2_packet traffic counters
+ * @rx_packets: Number of frames delivered to the rx_callback
+ * @rx_bytes: Number of bytes delivered to the rx_callback
+ * @rx_dropped: Number of received frames dropped before the rx_callback, e.g.,
+ *	duplicates filtered by the bridge workaround or failed reads
+ * @tx_packets: Number of frames sent successfully
+ * @tx_bytes: Number of bytes sent successfully
+ * @tx_errors: Number of failed send operations
+ */
+struct l2_packet_stats {
+	unsigned long rx_packets;
+	unsigned long rx_bytes;
+	unsigned long rx_dropped;
+	unsigned long tx_packets;
+	unsigned long tx_bytes;
+	unsigned long tx_errors;
+};
+
+/**
+ * l2_packet_get_stats - Get traffic counters for l2_packet
+ * @l2: Pointer to internal l2_packet data from l2_packet_init()
+ * @stats: Buffer for the counters
+ * Returns: 0 on success, -1 if counters are not available
+ *
+ * This function is used only for status information, so l2_packet
+ * implementations that do not maintain counters can return -1.
+ */
+int l2_packet_get_stats(struct l2_packet_data *l2,
+			struct l2_packet_stats *stats);
+
 #endif /* L2_PACKET_H */
@@ -29,6 +29,7 @@ struct l2_packet_data {
 	void *rx_callback_ctx;
 	int l2_hdr; /* whether to include layer 2 (Ethernet) header data
 		     * buffers */
+	struct l2_packet_stats stats;
 
 #ifndef CONFIG_NO_LINUX_PACKET_SOCKET_WAR
 	/* For working around Linux packet socket behavior and regression. */
@@ -141,6 +142,12 @@ int l2_packet_send(struct l2_packet_data *l2, const u8 *dst_addr, u16 proto,
 				   strerror(errno));
 		}
 	}
+	if (ret < 0) {
+		l2->stats.tx_errors++;
+	} else {
+		l2->stats.tx_packets++;
+		l2->stats.tx_bytes += ret;
+	}
 	return ret;
 }
 
@@ -160,6 +167,7 @@ static void l2_packet_receive(int sock, void *eloop_ctx, void *sock_ctx)
 	if (res < 0) {
 		wpa_printf(MSG_DEBUG, "l2_packet_receive - recvfrom: %s",
 			   strerror(errno));
+		l2->stats.rx_dropped++;
 		return;
 	}
 
@@ -196,12 +204,14 @@ static void l2_packet_receive(int sock, void *eloop_ctx, void *sock_ctx)
 		    os_memcmp(hash, l2->last_hash, SHA1_MAC_LEN) == 0) {
 			wpa_printf(MSG_DEBUG, "%s: Drop duplicate RX",
 				   __func__);
+			l2->stats.rx_dropped++;
 			return;
 		}
 		if (l2->last_from_br_prev &&
 		    os_memcmp(hash, l2->last_hash_prev, SHA1_MAC_LEN) == 0) {
 			wpa_printf(MSG_DEBUG, "%s: Drop duplicate RX(prev)",
 				   __func__);
+			l2->stats.rx_dropped++;
 			return;
 		}
 		os_memcpy(l2->last_hash_prev, l2->last_hash, SHA1_MAC_LEN);
@@ -211,6 +221,8 @@ static void l2_packet_receive(int sock, void *eloop_ctx, void *sock_ctx)
 
 	l2->last_from_br = 0;
 #endif /* CONFIG_NO_LINUX_PACKET_SOCKET_WAR */
+	l2->stats.rx_packets++;
+	l2->stats.rx_bytes += res;
 	l2->rx_callback(l2->rx_callback_ctx, ll.sll_addr, buf, res);
 }
 
@@ -235,6 +247,7 @@ static void l2_packet_receive_br(int sock, void *eloop_ctx, void *sock_ctx)
 	if (res < 0) {
 		wpa_printf(MSG_DEBUG, "l2_packet_receive_br - recvfrom: %s",
 			   strerror(errno));
+		l2->stats.rx_dropped++;
 		return;
 	}
 
@@ -243,6 +256,7 @@ static void l2_packet_receive_br(int sock, void *eloop_ctx, void *sock_ctx)
 
 	if (ether_addr_equal(ll.sll_addr, l2->own_addr)) {
 		wpa_printf(MSG_DEBUG, "%s: Drop RX of own frame", __func__);
+		l2->stats.rx_dropped++;
 		return;
 	}
 
@@ -252,17 +266,21 @@ static void l2_packet_receive_br(int sock, void *eloop_ctx, void *sock_ctx)
 	if (!l2->last_from_br &&
 	    os_memcmp(hash, l2->last_hash, SHA1_MAC_LEN) == 0) {
 		wpa_printf(MSG_DEBUG, "%s: Drop duplicate RX", __func__);
+		l2->stats.rx_dropped++;
 		return;
 	}
 	if (!l2->last_from_br_prev &&
 	    os_memcmp(hash, l2->last_hash_prev, SHA1_MAC_LEN) == 0) {
 		wpa_printf(MSG_DEBUG, "%s: Drop duplicate RX(prev)", __func__);
+		l2->stats.rx_dropped++;
 		return;
 	}
 	os_memcpy(l2->last_hash_prev, l2->last_hash, SHA1_MAC_LEN);
 	l2->last_from_br_prev = l2->last_from_br;
 	l2->last_from_br = 1;
 	os_memcpy(l2->last_hash, hash, SHA1_MAC_LEN);
+	l2->stats.rx_packets++;
+	l2->stats.rx_bytes += res;
 	l2->rx_callback(l2->rx_callback_ctx, ll.sll_addr, buf, res);
 }
 #endif /* CONFIG_NO_LINUX_PACKET_SOCKET_WAR */
@@ -513,3 +531,13 @@ int l2_packet_set_packet_filter(struct l2_packet_data *l2,
 
 	return 0;
 }
+
+
+int l2_packet_get_stats(struct l2_packet_data *l2,
+			struct l2_packet_stats *stats)
+{
+	if (!l2)
+		return -1;
+	os_memcpy(stats, &l2->stats, sizeof(*stats));
+	return 0;
+}
@@ -135,3 +135,10 @@ int l2_packet_set_packet_filter(struct l2_packet_data *l2,
 {
 	return -1;
 }
+
+
+int l2_packet_get_stats(struct l2_packet_data *l2,
+			struct l2_packet_stats *stats)
+{
+	return -1;
+}
@@ -348,3 +348,10 @@ void l2_packet_notify_auth_start(struct l2_packet_data *l2)
 	if (l2)
 		SetEvent(l2->rx_notify);
 }
+
+
+int l2_packet_get_stats(struct l2_packet_data *l2,
+			struct l2_packet_stats *stats)
+{
+	return -1;
+}
@@ -24,6 +24,7 @@
 static FILE *wpa_debug_tracing_file = NULL;
 
 #define WPAS_TRACE_PFX "wpas <%d>: "
+#define WPAS_TRACE_BUF_LEN 1024
 #endif /* CONFIG_DEBUG_LINUX_TRACING */
 
 
@@ -244,12 +245,29 @@ void wpa_printf(int level, const char *fmt, ...)
 
 #ifdef CONFIG_DEBUG_LINUX_TRACING
 	if (wpa_debug_tracing_file != NULL) {
+		char buf[WPAS_TRACE_BUF_LEN];
+		int len, res;
+
+		/*
+		 * Write each message with a single write() call instead of
+		 * going through stdio buffering and flushing for each line.
+		 * The kernel truncates long trace_marker writes anyway.
+		 */
+		len = os_snprintf(buf, sizeof(buf), WPAS_TRACE_PFX, level);
+		if (os_snprintf_error(sizeof(buf), len))
+			return;
 		va_start(ap, fmt);
-		fprintf(wpa_debug_tracing_file, WPAS_TRACE_PFX, level);
-		vfprintf(wpa_debug_tracing_file, fmt, ap);
-		fprintf(wpa_debug_tracing_file, "\n");
-		fflush(wpa_debug_tracing_file);
+		res = vsnprintf(buf + len, sizeof(buf) - len - 1, fmt, ap);
 		va_end(ap);
+		if (res < 0)
+			return;
+		len += res;
+		if ((size_t) len > sizeof(buf) - 2)
+			len = sizeof(buf) - 2;
+		buf[len++] = '\n';
+		if (write(fileno(wpa_debug_tracing_file), buf, len) < 0) {
+			/* Nothing much to do here */
+		}
 	}
 #endif /* CONFIG_DEBUG_LINUX_TRACING */
 }
@@ -627,6 +645,48 @@ void wpa_debug_setup_stdout(void)
 #endif /* CONFIG_NO_STDOUT_DEBUG */
 
 
+#if !defined(CONFIG_NO_WPA_MSG) || !defined(CONFIG_NO_HOSTAPD_LOGGER)
+
+/*
+ * Most messages fit into a buffer on the stack, so they can be formatted only
+ * once and without a heap allocation.
+ */
+#define WPA_MSG_BUF_LEN 256
+
+static char * wpa_msg_vformat(char *sbuf, size_t sbuf_len, const char *fmt,
+			      va_list ap, int *len)
+{
+	va_list ap2;
+	char *buf;
+	int res;
+
+	va_copy(ap2, ap);
+	res = vsnprintf(sbuf, sbuf_len, fmt, ap2);
+	va_end(ap2);
+	if (res < 0)
+		return NULL;
+	*len = res;
+	if ((size_t) res < sbuf_len)
+		return sbuf;
+
+	buf = os_malloc(res + 1);
+	if (buf)
+		vsnprintf(buf, res + 1, fmt, ap);
+	return buf;
+}
+
+
+static void wpa_msg_buf_free(char *buf, char *sbuf, int len)
+{
+	if (buf == sbuf)
+		forced_memzero(sbuf, len);
+	else
+		bin_clear_free(buf, len + 1);
+}
+
+#endif /* !CONFIG_NO_WPA_MSG || !CONFIG_NO_HOSTAPD_LOGGER */
+
+
 #ifndef CONFIG_NO_WPA_MSG
 static wpa_msg_cb_func wpa_msg_cb = NULL;
 
@@ -636,6 +696,32 @@ void wpa_msg_register_cb(wpa_msg_cb_func func)
 }
 
 
+static wpa_msg_check_func wpa_msg_check_cb = NULL;
+
+void wpa_msg_register_check_cb(wpa_msg_check_func func)
+{
+	wpa_msg_check_cb = func;
+}
+
+
+static int wpa_msg_needed(void *ctx, int level, enum wpa_msg_type type,
+			  int print)
+{
+#ifndef CONFIG_NO_STDOUT_DEBUG
+	if (print && level >= wpa_debug_level)
+		return 1;
+#ifdef CONFIG_DEBUG_LINUX_TRACING
+	if (print && wpa_debug_tracing_file)
+		return 1;
+#endif /* CONFIG_DEBUG_LINUX_TRACING */
+#endif /* CONFIG_NO_STDOUT_DEBUG */
+
+	if (!wpa_msg_cb)
+		return 0;
+	return !wpa_msg_check_cb || wpa_msg_check_cb(ctx, level, type);
+}
+
+
 static wpa_msg_get_ifname_func wpa_msg_ifname_cb = NULL;
 
 void wpa_msg_register_ifname_cb(wpa_msg_get_ifname_func func)
@@ -647,22 +733,22 @@ void wpa_msg_register_ifname_cb(wpa_msg_get_ifname_func func)
 void wpa_msg(void *ctx, int level, const char *fmt, ...)
 {
 	va_list ap;
+	char sbuf[WPA_MSG_BUF_LEN];
 	char *buf;
-	int buflen;
 	int len;
 	char prefix[130];
 
+	if (!wpa_msg_needed(ctx, level, WPA_MSG_PER_INTERFACE, 1))
+		return;
+
 	va_start(ap, fmt);
-	buflen = vsnprintf(NULL, 0, fmt, ap) + 1;
+	buf = wpa_msg_vformat(sbuf, sizeof(sbuf), fmt, ap, &len);
 	va_end(ap);
-
-	buf = os_malloc(buflen);
 	if (buf == NULL) {
 		wpa_printf(MSG_ERROR, "wpa_msg: Failed to allocate message "
 			   "buffer");
 		return;
 	}
-	va_start(ap, fmt);
 	prefix[0] = '\0';
 	if (wpa_msg_ifname_cb) {
 		const char *ifname = wpa_msg_ifname_cb(ctx);
@@ -673,149 +759,131 @@ void wpa_msg(void *ctx, int level, const char *fmt, ...)
 				prefix[0] = '\0';
 		}
 	}
-	len = vsnprintf(buf, buflen, fmt, ap);
-	va_end(ap);
 	wpa_printf(level, "%s%s", prefix, buf);
 	if (wpa_msg_cb)
 		wpa_msg_cb(ctx, level, WPA_MSG_PER_INTERFACE, buf, len);
-	bin_clear_free(buf, buflen);
+	wpa_msg_buf_free(buf, sbuf, len);
 }
 
 
 void wpa_msg_ctrl(void *ctx, int level, const char *fmt, ...)
 {
 	va_list ap;
+	char sbuf[WPA_MSG_BUF_LEN];
 	char *buf;
-	int buflen;
 	int len;
 
-	if (!wpa_msg_cb)
+	if (!wpa_msg_needed(ctx, level, WPA_MSG_PER_INTERFACE, 0))
 		return;
 
 	va_start(ap, fmt);
-	buflen = vsnprintf(NULL, 0, fmt, ap) + 1;
+	buf = wpa_msg_vformat(sbuf, sizeof(sbuf), fmt, ap, &len);
 	va_end(ap);
-
-	buf = os_malloc(buflen);
 	if (buf == NULL) {
 		wpa_printf(MSG_ERROR, "wpa_msg_ctrl: Failed to allocate "
 			   "message buffer");
 		return;
 	}
-	va_start(ap, fmt);
-	len = vsnprintf(buf, buflen, fmt, ap);
-	va_end(ap);
 	wpa_msg_cb(ctx, level, WPA_MSG_PER_INTERFACE, buf, len);
-	bin_clear_free(buf, buflen);
+	wpa_msg_buf_free(buf, sbuf, len);
 }
 
 
 void wpa_msg_global(void *ctx, int level, const char *fmt, ...)
 {
 	va_list ap;
+	char sbuf[WPA_MSG_BUF_LEN];
 	char *buf;
-	int buflen;
 	int len;
 
+	if (!wpa_msg_needed(ctx, level, WPA_MSG_GLOBAL, 1))
+		return;
+
 	va_start(ap, fmt);
-	buflen = vsnprintf(NULL, 0, fmt, ap) + 1;
+	buf = wpa_msg_vformat(sbuf, sizeof(sbuf), fmt, ap, &len);
 	va_end(ap);
-
-	buf = os_malloc(buflen);
 	if (buf == NULL) {
 		wpa_printf(MSG_ERROR, "wpa_msg_global: Failed to allocate "
 			   "message buffer");
 		return;
 	}
-	va_start(ap, fmt);
-	len = vsnprintf(buf, buflen, fmt, ap);
-	va_end(ap);
 	wpa_printf(level, "%s", buf);
 	if (wpa_msg_cb)
 		wpa_msg_cb(ctx, level, WPA_MSG_GLOBAL, buf, len);
-	bin_clear_free(buf, buflen);
+	wpa_msg_buf_free(buf, sbuf, len);
 }
 
 
 void wpa_msg_global_ctrl(void *ctx, int level, const char *fmt, ...)
 {
 	va_list ap;
+	char sbuf[WPA_MSG_BUF_LEN];
 	char *buf;
-	int buflen;
 	int len;
 
-	if (!wpa_msg_cb)
+	if (!wpa_msg_needed(ctx, level, WPA_MSG_GLOBAL, 0))
 		return;
 
 	va_start(ap, fmt);
-	buflen = vsnprintf(NULL, 0, fmt, ap) + 1;
+	buf = wpa_msg_vformat(sbuf, sizeof(sbuf), fmt, ap, &len);
 	va_end(ap);
-
-	buf = os_malloc(buflen);
 	if (buf == NULL) {
 		wpa_printf(MSG_ERROR,
 			   "wpa_msg_global_ctrl: Failed to allocate message buffer");
 		return;
 	}
-	va_start(ap, fmt);
-	len = vsnprintf(buf, buflen, fmt, ap);
-	va_end(ap);
 	wpa_msg_cb(ctx, level, WPA_MSG_GLOBAL, buf, len);
-	bin_clear_free(buf, buflen);
+	wpa_msg_buf_free(buf, sbuf, len);
 }
 
 
 void wpa_msg_no_global(void *ctx, int level, const char *fmt, ...)
 {
 	va_list ap;
+	char sbuf[WPA_MSG_BUF_LEN];
 	char *buf;
-	int buflen;
 	int len;
 
+	if (!wpa_msg_needed(ctx, level, WPA_MSG_NO_GLOBAL, 1))
+		return;
+
 	va_start(ap, fmt);
-	buflen = vsnprintf(NULL, 0, fmt, ap) + 1;
+	buf = wpa_msg_vformat(sbuf, sizeof(sbuf), fmt, ap, &len);
 	va_end(ap);
-
-	buf = os_malloc(buflen);
 	if (buf == NULL) {
 		wpa_printf(MSG_ERROR, "wpa_msg_no_global: Failed to allocate "
 			   "message buffer");
 		return;
 	}
-	va_start(ap, fmt);
-	len = vsnprintf(buf, buflen, fmt, ap);
-	va_end(ap);
 	wpa_printf(level, "%s", buf);
 	if (wpa_msg_cb)
 		wpa_msg_cb(ctx, level, WPA_MSG_NO_GLOBAL, buf, len);
-	bin_clear_free(buf, buflen);
+	wpa_msg_buf_free(buf, sbuf, len);
 }
 
 
 void wpa_msg_global_only(void *ctx, int level, const char *fmt, ...)
 {
 	va_list ap;
+	char sbuf[WPA_MSG_BUF_LEN];
 	char *buf;
-	int buflen;
 	int len;
 
+	if (!wpa_msg_needed(ctx, level, WPA_MSG_ONLY_GLOBAL, 1))
+		return;
+
 	va_start(ap, fmt);
-	buflen = vsnprintf(NULL, 0, fmt, ap) + 1;
+	buf = wpa_msg_vformat(sbuf, sizeof(sbuf), fmt, ap, &len);
 	va_end(ap);
-
-	buf = os_malloc(buflen);
 	if (buf == NULL) {
 		wpa_printf(MSG_ERROR, "%s: Failed to allocate message buffer",
 			   __func__);
 		return;
 	}
-	va_start(ap, fmt);
-	len = vsnprintf(buf, buflen, fmt, ap);
-	va_end(ap);
 	wpa_printf(level, "%s", buf);
 	if (wpa_msg_cb)
 		wpa_msg_cb(ctx, level, WPA_MSG_ONLY_GLOBAL, buf, len);
-	os_free(buf);
+	wpa_msg_buf_free(buf, sbuf, len);
 }
 
 #endif /* CONFIG_NO_WPA_MSG */
@@ -834,23 +902,18 @@ void hostapd_logger(void *ctx, const u8 *addr, unsigned int module, int level,
 		    const char *fmt, ...)
 {
 	va_list ap;
+	char sbuf[WPA_MSG_BUF_LEN];
 	char *buf;
-	int buflen;
 	int len;
 
 	va_start(ap, fmt);
-	buflen = vsnprintf(NULL, 0, fmt, ap) + 1;
+	buf = wpa_msg_vformat(sbuf, sizeof(sbuf), fmt, ap, &len);
 	va_end(ap);
-
-	buf = os_malloc(buflen);
 	if (buf == NULL) {
 		wpa_printf(MSG_ERROR, "hostapd_logger: Failed to allocate "
 			   "message buffer");
 		return;
 	}
-	va_start(ap, fmt);
-	len = vsnprintf(buf, buflen, fmt, ap);
-	va_end(ap);
 	if (hostapd_logger_cb)
 		hostapd_logger_cb(ctx, addr, module, level, buf, len);
 	else if (addr)
@@ -858,7 +921,7 @@ void hostapd_logger(void *ctx, const u8 *addr, unsigned int module, int level,
 			   MAC2STR(addr), buf);
 	else
 		wpa_printf(MSG_DEBUG, "hostapd_logger: %s", buf);
-	bin_clear_free(buf, buflen);
+	wpa_msg_buf_free(buf, sbuf, len);
 }
 #endif /* CONFIG_NO_HOSTAPD_LOGGER */
 
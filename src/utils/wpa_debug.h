@@ -168,6 +168,7 @@ void wpa_hexdump_ascii_key(int level, const char *title, const void *buf,
 #define wpa_msg_no_global(args...) do { } while (0)
 #define wpa_msg_global_only(args...) do { } while (0)
 #define wpa_msg_register_cb(f) do { } while (0)
+#define wpa_msg_register_check_cb(f) do { } while (0)
 #define wpa_msg_register_ifname_cb(f) do { } while (0)
 #else /* CONFIG_NO_WPA_MSG */
 /**
@@ -276,6 +277,20 @@ typedef void (*wpa_msg_cb_func)(void *ctx, int level, enum wpa_msg_type type,
  */
 void wpa_msg_register_cb(wpa_msg_cb_func func);
 
+typedef int (*wpa_msg_check_func)(void *ctx, int level,
+				  enum wpa_msg_type type);
+
+/**
+ * wpa_msg_register_check_cb - Register callback for checking message delivery
+ * @func: Callback function (%NULL to unregister)
+ *
+ * The callback function returns whether a message with the specified level
+ * and type would be delivered by the function registered with
+ * wpa_msg_register_cb(). This is used to skip formatting of messages that
+ * would not be shown in debug output nor delivered to any ctrl_iface monitor.
+ */
+void wpa_msg_register_check_cb(wpa_msg_check_func func);
+
 typedef const char * (*wpa_msg_get_ifname_func)(void *ctx);
 void wpa_msg_register_ifname_cb(wpa_msg_get_ifname_func func);
 
@@ -449,6 +449,55 @@ def test_wpas_config_file_set_psk(dev):
         except:
             pass
 
+def test_wpas_config_file_unchanged(dev):
+    """wpa_supplicant config file not replaced when contents do not change"""
+    config = "/tmp/test_wpas_config_file.conf"
+    if os.path.exists(config):
+        os.remove(config)
+
+    wpas = WpaSupplicant(global_iface='/tmp/wpas-wlan5')
+
+    try:
+        with open(config, "w") as f:
+            f.write("update_config=1\n")
+
+        wpas.interface_add("wlan5", config=config)
+
+        id = wpas.add_network()
+        wpas.set_network_quoted(id, "ssid", "foo")
+        wpas.set_network(id, "key_mgmt", "NONE")
+        if "OK" not in wpas.request("SAVE_CONFIG"):
+            raise Exception("Failed to save configuration file")
+        ino = os.stat(config).st_ino
+
+        if "OK" not in wpas.request("SAVE_CONFIG"):
+            raise Exception("Failed to save configuration file")
+        if os.stat(config).st_ino != ino:
+            raise Exception("Unchanged configuration file was replaced")
+        if os.path.exists(config + ".tmp"):
+            raise Exception("Temporary configuration file left behind")
+
+        wpas.set_network(id, "priority", "5")
+        if "OK" not in wpas.request("SAVE_CONFIG"):
+            raise Exception("Failed to save configuration file")
+        if os.stat(config).st_ino == ino:
+            raise Exception("Modified configuration file was not replaced")
+        with open(config, "r") as f:
+            data = f.read()
+            logger.info("Configuration file contents: " + data)
+            if "priority=5" not in data:
+                raise Exception("Updated parameter not written")
+
+    finally:
+        try:
+            os.remove(config)
+        except:
+            pass
+        try:
+            os.remove(config + ".tmp")
+        except:
+            pass
+
 def test_wpas_config_file_set_cred(dev):
     """wpa_supplicant config file parsing/writing with arbitrary cred values"""
     config = "/tmp/test_wpas_config_file.conf"
@@ -14,40 +14,88 @@
 
 #define BLOCK_SIZE 16
 
-static void test_aes_perf(void)
+static void test_aes_perf_report(const char *name, struct os_reltime *start,
+				 int frames, size_t len)
 {
-#if 0 /* this did not seem to work with new compiler?! */
-#ifdef __i386__
-#define rdtscll(val) \
-     __asm__ __volatile__("rdtsc" : "=A" (val))
-	const int num_iters = 10;
-	int i;
-	unsigned int start, end;
-	u8 key[16], pt[16], ct[16];
-	void *ctx;
+	struct os_reltime now, diff;
+	double sec;
+
+	os_get_reltime(&now);
+	os_reltime_sub(&now, start, &diff);
+	sec = diff.sec + diff.usec / 1000000.0;
+	if (sec <= 0)
+		sec = 0.000001;
+	printf("%s: %d frames of %u octets in %.3f s: %.0f frames/s, %.1f MB/s\n",
+	       name, frames, (unsigned int) len, sec, frames / sec,
+	       frames * len / sec / 1000000.0);
+}
 
-	printf("keySetupEnc:");
-	for (i = 0; i < num_iters; i++) {
-		rdtscll(start);
-		ctx = aes_encrypt_init(key, 16);
-		rdtscll(end);
-		aes_encrypt_deinit(ctx);
-		printf(" %d", end - start);
+
+static int test_aes_perf(void)
+{
+	const int num_frames = 20000;
+	const size_t len = 1500;
+	u8 key[16], nonce[13], iv[12], aad[22], tag[16];
+	u8 *plain, *crypt;
+	struct os_reltime start;
+	void *ctx;
+	int i, ret = 0;
+	u8 block[16];
+
+	plain = os_zalloc(len);
+	crypt = os_zalloc(len);
+	if (!plain || !crypt) {
+		os_free(plain);
+		os_free(crypt);
+		return 1;
 	}
-	printf("\n");
-
-	printf("Encrypt:");
-	ctx = aes_encrypt_init(key, 16);
-	for (i = 0; i < num_iters; i++) {
-		rdtscll(start);
-		aes_encrypt(ctx, pt, ct);
-		rdtscll(end);
-		printf(" %d", end - start);
+	os_memset(key, 0x11, sizeof(key));
+	os_memset(nonce, 0x22, sizeof(nonce));
+	os_memset(iv, 0x33, sizeof(iv));
+	os_memset(aad, 0x44, sizeof(aad));
+	os_memset(block, 0, sizeof(block));
+
+	ctx = aes_encrypt_init(key, sizeof(key));
+	if (!ctx) {
+		ret = 1;
+		goto out;
 	}
+	os_get_reltime(&start);
+	for (i = 0; i < num_frames * (int) (len / 16); i++)
+		aes_encrypt(ctx, block, block);
+	test_aes_perf_report("AES-128 block", &start, num_frames, len);
 	aes_encrypt_deinit(ctx);
-	printf("\n");
-#endif /* __i386__ */
-#endif
+
+	os_get_reltime(&start);
+	for (i = 0; i < num_frames; i++)
+		ret |= aes_ccm_ae(key, sizeof(key), nonce, 8, plain, len,
+				  aad, sizeof(aad), crypt, tag);
+	test_aes_perf_report("CCMP encrypt", &start, num_frames, len);
+
+	os_get_reltime(&start);
+	for (i = 0; i < num_frames; i++)
+		ret |= aes_ccm_ad(key, sizeof(key), nonce, 8, crypt, len,
+				  aad, sizeof(aad), tag, plain);
+	test_aes_perf_report("CCMP decrypt", &start, num_frames, len);
+
+	os_get_reltime(&start);
+	for (i = 0; i < num_frames; i++)
+		ret |= aes_gcm_ae(key, sizeof(key), iv, sizeof(iv), plain, len,
+				  aad, sizeof(aad), crypt, tag);
+	test_aes_perf_report("GCMP encrypt", &start, num_frames, len);
+
+	os_get_reltime(&start);
+	for (i = 0; i < num_frames; i++)
+		ret |= aes_gcm_ad(key, sizeof(key), iv, sizeof(iv), crypt, len,
+				  aad, sizeof(aad), tag, plain);
+	test_aes_perf_report("GCMP decrypt", &start, num_frames, len);
+
+out:
+	os_free(plain);
+	os_free(crypt);
+	if (ret)
+		printf("Performance test failed\n");
+	return ret;
 }
 
 
@@ -612,8 +660,8 @@ int main(int argc, char *argv[])
 		ret += test_nist_key_wrap_ae(argv[2]);
 	else if (argc >= 3 && os_strcmp(argv[1], "NIST-KW-AD") == 0)
 		ret += test_nist_key_wrap_ad(argv[2]);
-
-	test_aes_perf();
+	else if (argc >= 2 && os_strcmp(argv[1], "perf") == 0)
+		return test_aes_perf();
 
 	ret += test_gcm();
 
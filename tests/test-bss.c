@@ -11,7 +11,9 @@
 #include "utils/includes.h"
 
 #include "utils/common.h"
+#include "common/ieee802_11_common.h"
 #include "wpa_supplicant_i.h"
+#include "../wpa_supplicant/config.h"
 #include "bss.h"
 
 #define ASSERT_CMP_INT(a, cmp, b) { \
@@ -50,6 +52,7 @@ void test_parse_basic_ml(struct wpa_supplicant *wpa_s, u8 mld_id)
 	u8 ret;
 	u8 ap_mld_id;
 
+	memset(&bss, 0, sizeof(bss));
 	memcpy(bss.bss.ies, mld_ie, sizeof(mld_ie));
 	bss.bss.ie_len = sizeof(mld_ie);
 
@@ -68,6 +71,180 @@ void test_parse_basic_ml(struct wpa_supplicant *wpa_s, u8 mld_id)
 	ASSERT_CMP_INT(ap_mld_id, ==, mld_id);
 }
 
+static void test_bss_add(struct wpa_supplicant *wpa_s, int i,
+			 struct os_reltime *fetch_time)
+{
+	struct {
+		struct wpa_scan_res res;
+		u8 ies[200];
+	} r;
+	u8 *pos = r.ies;
+
+	memset(&r, 0, sizeof(r));
+	r.res.bssid[0] = 0x02;
+	WPA_PUT_BE16(&r.res.bssid[4], i);
+	r.res.freq = 2412;
+	r.res.level = -50;
+
+	*pos++ = WLAN_EID_SSID;
+	*pos++ = 6;
+	memcpy(pos, "test", 4);
+	WPA_PUT_BE16(pos + 4, i);
+	pos += 6;
+	*pos++ = WLAN_EID_SUPP_RATES;
+	*pos++ = 4;
+	memcpy(pos, "\x82\x84\x8b\x96", 4);
+	pos += 4;
+	*pos++ = WLAN_EID_VENDOR_SPECIFIC;
+	*pos++ = 7;
+	WPA_PUT_BE32(pos, WMM_IE_VENDOR_TYPE);
+	pos += 7;
+	if (i % 2) {
+		*pos++ = WLAN_EID_RSN;
+		*pos++ = 20;
+		memcpy(pos, "\x01\x00\x00\x0f\xac\x04\x01\x00\x00\x0f\xac\x04"
+		       "\x01\x00\x00\x0f\xac\x02\x00\x00", 20);
+		pos += 20;
+	}
+	*pos++ = WLAN_EID_EXTENSION;
+	*pos++ = 7;
+	*pos++ = WLAN_EID_EXT_HE_OPERATION;
+	pos += 6;
+	if (i % 3 == 0) {
+		/* Fragmented vendor element payload */
+		*pos++ = WLAN_EID_VENDOR_SPECIFIC;
+		*pos++ = 6;
+		WPA_PUT_BE32(pos, P2P_IE_VENDOR_TYPE);
+		pos[4] = 0x11;
+		pos[5] = i;
+		pos += 6;
+		*pos++ = WLAN_EID_EXT_SUPP_RATES;
+		*pos++ = 1;
+		*pos++ = 0x0c;
+		*pos++ = WLAN_EID_VENDOR_SPECIFIC;
+		*pos++ = 5;
+		WPA_PUT_BE32(pos, P2P_IE_VENDOR_TYPE);
+		pos[4] = 0x22;
+		pos += 5;
+	}
+	r.res.ie_len = pos - r.ies;
+
+	wpa_bss_update_scan_res(wpa_s, &r.res, fetch_time);
+}
+
+
+static void test_bss_lookup(struct wpa_bss *bss)
+{
+	static const u8 eids[] = {
+		WLAN_EID_SSID, WLAN_EID_SUPP_RATES, WLAN_EID_EXT_SUPP_RATES,
+		WLAN_EID_RSN, WLAN_EID_RSNX, WLAN_EID_VENDOR_SPECIFIC,
+		WLAN_EID_EXTENSION, WLAN_EID_MOBILITY_DOMAIN,
+	};
+	static const u8 ext_eids[] = {
+		WLAN_EID_EXT_HE_OPERATION, WLAN_EID_EXT_MULTI_LINK,
+	};
+	static const u32 vendor_types[] = {
+		WMM_IE_VENDOR_TYPE, P2P_IE_VENDOR_TYPE, WPA_IE_VENDOR_TYPE,
+		MBO_IE_VENDOR_TYPE,
+	};
+	const u8 *ies = wpa_bss_ie_ptr(bss);
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(eids); i++)
+		ASSERT_CMP_INT((long) wpa_bss_get_ie(bss, eids[i]), ==,
+			       (long) get_ie(ies, bss->ie_len, eids[i]));
+	for (i = 0; i < ARRAY_SIZE(ext_eids); i++)
+		ASSERT_CMP_INT((long) wpa_bss_get_ie_ext(bss, ext_eids[i]), ==,
+			       (long) get_ie_ext(ies, bss->ie_len,
+						 ext_eids[i]));
+	for (i = 0; i < ARRAY_SIZE(vendor_types); i++) {
+		struct wpabuf *a, *b;
+		struct wpa_bss_ie_index *idx;
+		const u8 *ie;
+
+		ie = wpa_bss_get_vendor_ie(bss, vendor_types[i]);
+		a = wpa_bss_get_vendor_ie_multi(bss, vendor_types[i]);
+		/* Compare against parsing the IE field without the index */
+		idx = bss->ie_index;
+		bss->ie_index = NULL;
+		ASSERT_CMP_INT((long) ie, ==,
+			       (long) wpa_bss_get_vendor_ie(bss,
+							    vendor_types[i]));
+		b = wpa_bss_get_vendor_ie_multi(bss, vendor_types[i]);
+		bss->ie_index = idx;
+		ASSERT_CMP_INT(!a, ==, !b);
+		if (a)
+			ASSERT_CMP_INT(wpabuf_cmp(a, b), ==, 0);
+		wpabuf_free(a);
+		wpabuf_free(b);
+	}
+}
+
+
+static void test_bss_selection_lookups(struct wpa_supplicant *wpa_s)
+{
+	struct wpa_bss *bss;
+
+	dl_list_for_each(bss, &wpa_s->bss, struct wpa_bss, list) {
+		wpa_bss_get_ie(bss, WLAN_EID_SSID);
+		wpa_bss_get_ie(bss, WLAN_EID_RSN);
+		wpa_bss_get_ie(bss, WLAN_EID_RSNX);
+		wpa_bss_get_vendor_ie(bss, WPA_IE_VENDOR_TYPE);
+		wpa_bss_get_vendor_ie(bss, WPS_IE_VENDOR_TYPE);
+		wpa_bss_get_vendor_ie(bss, OWE_IE_VENDOR_TYPE);
+		wpa_bss_get_vendor_ie(bss, MBO_IE_VENDOR_TYPE);
+		wpa_bss_get_ie_ext(bss, WLAN_EID_EXT_MULTI_LINK);
+		wpa_bss_get_ie(bss, WLAN_EID_MOBILITY_DOMAIN);
+		wpa_bss_get_ie(bss, WLAN_EID_EXT_CAPAB);
+	}
+}
+
+
+void test_bss_ie_index(struct wpa_supplicant *wpa_s, int num_bss)
+{
+	struct os_reltime fetch_time, start, end, diff;
+	struct wpa_bss *bss;
+	int i, prev_level = wpa_debug_level;
+	unsigned int bss_max_count = wpa_s->conf->bss_max_count;
+
+	wpa_debug_level = MSG_INFO;
+	wpa_s->conf->bss_max_count = num_bss;
+	os_get_reltime(&fetch_time);
+	wpa_bss_update_start(wpa_s);
+	for (i = 0; i < num_bss; i++)
+		test_bss_add(wpa_s, i, &fetch_time);
+	ASSERT_CMP_INT(wpa_s->num_bss, ==, num_bss);
+
+	dl_list_for_each(bss, &wpa_s->bss, struct wpa_bss, list) {
+		ASSERT_CMP_INT(!bss->ie_index, ==, 0);
+		test_bss_lookup(bss);
+	}
+
+	os_get_reltime(&start);
+	for (i = 0; i < 100; i++)
+		test_bss_selection_lookups(wpa_s);
+	os_get_reltime(&end);
+	os_reltime_sub(&end, &start, &diff);
+	printf("%d BSSes, 100 selection rounds with element index: %ld.%06ld s\n",
+	       num_bss, (long) diff.sec, (long) diff.usec);
+
+	dl_list_for_each(bss, &wpa_s->bss, struct wpa_bss, list) {
+		os_free(bss->ie_index);
+		bss->ie_index = NULL;
+	}
+	os_get_reltime(&start);
+	for (i = 0; i < 100; i++)
+		test_bss_selection_lookups(wpa_s);
+	os_get_reltime(&end);
+	os_reltime_sub(&end, &start, &diff);
+	printf("%d BSSes, 100 selection rounds without element index: %ld.%06ld s\n",
+	       num_bss, (long) diff.sec, (long) diff.usec);
+
+	wpa_bss_flush(wpa_s);
+	wpa_s->conf->bss_max_count = bss_max_count;
+	wpa_debug_level = prev_level;
+}
+
 #define RUN_TEST(func, ...) do {			\
 		func(wpa_s, __VA_ARGS__);		\
 		printf("\nok " #func " " #__VA_ARGS__ "\n\n");		\
@@ -91,6 +268,7 @@ int main(void)
 
 	RUN_TEST(test_parse_basic_ml, 0);
 	RUN_TEST(test_parse_basic_ml, 1);
+	RUN_TEST(test_bss_ie_index, 500);
 
 	return 0;
 }
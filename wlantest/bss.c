@@ -20,7 +20,7 @@ struct wlantest_bss * bss_find(struct wlantest *wt, const u8 *bssid)
 {
 	struct wlantest_bss *bss;
 
-	dl_list_for_each(bss, &wt->bss, struct wlantest_bss, list) {
+	for (bss = wt->bss_hash[WLANTEST_HASH(bssid)]; bss; bss = bss->hnext) {
 		if (ether_addr_equal(bss->bssid, bssid))
 			return bss;
 	}
@@ -64,6 +64,8 @@ struct wlantest_bss * bss_get(struct wlantest *wt, const u8 *bssid)
 	dl_list_init(&bss->tdls);
 	os_memcpy(bss->bssid, bssid, ETH_ALEN);
 	dl_list_add(&wt->bss, &bss->list);
+	bss->hnext = wt->bss_hash[WLANTEST_HASH(bssid)];
+	wt->bss_hash[WLANTEST_HASH(bssid)] = bss;
 	wpa_printf(MSG_DEBUG, "Discovered new BSS - " MACSTR,
 		   MAC2STR(bss->bssid));
 	return bss;
@@ -84,17 +86,26 @@ void tdls_deinit(struct wlantest_tdls *tdls)
 }
 
 
-void bss_deinit(struct wlantest_bss *bss)
+void bss_deinit(struct wlantest *wt, struct wlantest_bss *bss)
 {
 	struct wlantest_sta *sta, *n;
 	struct wlantest_pmk *pmk, *np;
 	struct wlantest_tdls *tdls, *nt;
+	struct wlantest_bss **pos;
+
 	dl_list_for_each_safe(sta, n, &bss->sta, struct wlantest_sta, list)
 		sta_deinit(sta);
 	dl_list_for_each_safe(pmk, np, &bss->pmk, struct wlantest_pmk, list)
 		pmk_deinit(pmk);
 	dl_list_for_each_safe(tdls, nt, &bss->tdls, struct wlantest_tdls, list)
 		tdls_deinit(tdls);
+	for (pos = &wt->bss_hash[WLANTEST_HASH(bss->bssid)]; *pos;
+	     pos = &(*pos)->hnext) {
+		if (*pos == bss) {
+			*pos = bss->hnext;
+			break;
+		}
+	}
 	dl_list_del(&bss->list);
 	os_free(bss);
 }
@@ -411,5 +422,5 @@ void bss_flush(struct wlantest *wt)
 {
 	struct wlantest_bss *bss, *n;
 	dl_list_for_each_safe(bss, n, &wt->bss, struct wlantest_bss, list)
-		bss_deinit(bss);
+		bss_deinit(wt, bss);
 }
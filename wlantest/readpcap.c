@@ -55,6 +55,8 @@ int read_cap_file(struct wlantest *wt, const char *fname)
 	const u_char *data;
 	int res;
 	int dlt;
+	struct os_reltime start, end, diff;
+	double secs;
 
 	pcap = pcap_open_offline(fname, errbuf);
 	if (pcap == NULL) {
@@ -71,6 +73,7 @@ int read_cap_file(struct wlantest *wt, const char *fname)
 		return -1;
 	}
 	wpa_printf(MSG_DEBUG, "pcap datalink type: %d", dlt);
+	os_get_reltime(&start);
 
 	for (;;) {
 		clear_notes(wt);
@@ -130,7 +133,12 @@ int read_cap_file(struct wlantest *wt, const char *fname)
 
 	pcap_close(pcap);
 
+	os_get_reltime(&end);
+	os_reltime_sub(&end, &start, &diff);
+	secs = diff.sec + diff.usec / 1000000.0;
 	wpa_printf(MSG_DEBUG, "Read %s: %u packets", fname, count);
+	wpa_printf(MSG_INFO, "Processed %u frames in %.3f seconds (%.0f frames/sec)",
+		   count, secs, secs > 0 ? count / secs : 0.0);
 
 	return 0;
 }
@@ -190,21 +190,76 @@ static u8 * try_ptk(struct wlantest *wt, int pairwise_cipher,
 }
 
 
+static struct wlantest_ptk_cache *
+ptk_cache_entry(struct wlantest *wt, const u8 *a1, const u8 *a2, int keyid,
+		bool *match)
+{
+	struct wlantest_ptk_cache *entry;
+	const u8 *tmp;
+
+	/* Use the same entry for both directions of the link */
+	if (os_memcmp(a1, a2, ETH_ALEN) > 0) {
+		tmp = a1;
+		a1 = a2;
+		a2 = tmp;
+	}
+
+	entry = &wt->ptk_cache[(a1[5] ^ a2[5] ^ a2[4] ^ keyid) %
+			       WLANTEST_PTK_CACHE_SIZE];
+	*match = entry->ptk && entry->keyid == keyid &&
+		ether_addr_equal(entry->a1, a1) &&
+		ether_addr_equal(entry->a2, a2);
+	if (!*match) {
+		os_memcpy(entry->a1, a1, ETH_ALEN);
+		os_memcpy(entry->a2, a2, ETH_ALEN);
+		entry->keyid = keyid;
+		entry->ptk = NULL;
+	}
+	return entry;
+}
+
+
 static u8 * try_all_ptk(struct wlantest *wt, int pairwise_cipher,
 			const struct ieee80211_hdr *hdr,
 			const u8 *a1, const u8 *a2, const u8 *a3, int keyid,
 			const u8 *data, size_t data_len, size_t *decrypted_len)
 {
 	struct wlantest_ptk *ptk;
+	struct wlantest_ptk_cache *entry;
+	bool match;
 	u8 *decrypted;
 	int prev_level = wpa_debug_level;
 
+	/* All ciphers that can be tried here use Extended IV and a MIC */
+	if (data_len < 8 + 8 || !(data[3] & 0x20))
+		return NULL;
+
+	entry = ptk_cache_entry(wt, a1 ? a1 : hdr->addr1,
+				a2 ? a2 : hdr->addr2, keyid, &match);
+
 	wpa_debug_level = MSG_WARNING;
+	if (match) {
+		decrypted = try_ptk(wt, pairwise_cipher, &entry->ptk->ptk, hdr,
+				    a1, a2, a3, data, data_len, decrypted_len);
+		if (decrypted) {
+			wpa_debug_level = prev_level;
+			add_note(wt, MSG_DEBUG,
+				 "Found PTK match from the PTK cache");
+			write_decrypted_note(wt, decrypted,
+					     entry->ptk->ptk.tk,
+					     entry->ptk->ptk.tk_len, keyid);
+			return decrypted;
+		}
+	}
+
 	dl_list_for_each(ptk, &wt->ptk, struct wlantest_ptk, list) {
+		if (match && ptk == entry->ptk)
+			continue;
 		decrypted = try_ptk(wt, pairwise_cipher, &ptk->ptk, hdr, a1, a2,
 				    a3, data, data_len, decrypted_len);
 		if (decrypted) {
 			wpa_debug_level = prev_level;
+			entry->ptk = ptk;
 			add_note(wt, MSG_DEBUG,
 				 "Found PTK match from list of all known PTKs");
 			write_decrypted_note(wt, decrypted, ptk->ptk.tk,
@@ -266,6 +266,21 @@ static int try_pmk(struct wlantest *wt, struct wlantest_bss *bss,
 }
 
 
+static bool same_pmk(struct wlantest_sta *sta, struct wlantest_pmk *pmk)
+{
+	return sta->last_pmk_set && sta->last_pmk.pmk_len == pmk->pmk_len &&
+		os_memcmp(sta->last_pmk.pmk, pmk->pmk, pmk->pmk_len) == 0;
+}
+
+
+static void remember_pmk(struct wlantest_sta *sta, struct wlantest_pmk *pmk)
+{
+	os_memcpy(sta->last_pmk.pmk, pmk->pmk, pmk->pmk_len);
+	sta->last_pmk.pmk_len = pmk->pmk_len;
+	sta->last_pmk_set = 1;
+}
+
+
 static void derive_ptk(struct wlantest *wt, struct wlantest_bss *bss,
 		       struct wlantest_sta *sta, u16 ver,
 		       const u8 *data, size_t len)
@@ -275,16 +290,30 @@ static void derive_ptk(struct wlantest *wt, struct wlantest_bss *bss,
 	wpa_printf(MSG_DEBUG, "Trying to derive PTK for " MACSTR " (MLD " MACSTR
 		   ") (ver %u)",
 		   MAC2STR(sta->addr), MAC2STR(sta->mld_mac_addr), ver);
+	if (sta->last_pmk_set) {
+		wpa_printf(MSG_DEBUG, "Try previously used PMK");
+		if (try_pmk(wt, bss, sta, ver, data, len, &sta->last_pmk) == 0)
+			return;
+	}
+
 	dl_list_for_each(pmk, &bss->pmk, struct wlantest_pmk, list) {
+		if (same_pmk(sta, pmk))
+			continue;
 		wpa_printf(MSG_DEBUG, "Try per-BSS PMK");
-		if (try_pmk(wt, bss, sta, ver, data, len, pmk) == 0)
+		if (try_pmk(wt, bss, sta, ver, data, len, pmk) == 0) {
+			remember_pmk(sta, pmk);
 			return;
+		}
 	}
 
 	dl_list_for_each(pmk, &wt->pmk, struct wlantest_pmk, list) {
+		if (same_pmk(sta, pmk))
+			continue;
 		wpa_printf(MSG_DEBUG, "Try global PMK");
-		if (try_pmk(wt, bss, sta, ver, data, len, pmk) == 0)
+		if (try_pmk(wt, bss, sta, ver, data, len, pmk) == 0) {
+			remember_pmk(sta, pmk);
 			return;
+		}
 	}
 
 	if (!sta->ptk_set) {
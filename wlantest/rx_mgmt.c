@@ -1466,13 +1466,11 @@ static void rx_mgmt_reassoc_req(struct wlantest *wt, const u8 *data,
 
 		sta1 = sta_find_mlo(wt, bss, mld_addr);
 		if (sta1 && sta1->ft_over_ds) {
-			dl_list_del(&sta1->list);
-			dl_list_add(&bss->sta, &sta1->list);
 			wpa_printf(MSG_DEBUG,
 				   "Move existing STA entry from another affiliated BSS to the reassociation BSS (addr "
 				   MACSTR " -> " MACSTR ")",
 				   MAC2STR(sta1->addr), MAC2STR(mgmt->sa));
-			os_memcpy(sta1->addr, mgmt->sa, ETH_ALEN);
+			sta_move(sta1, bss, mgmt->sa);
 			sta = sta1;
 		}
 	}
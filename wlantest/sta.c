@@ -19,7 +19,7 @@ struct wlantest_sta * sta_find(struct wlantest_bss *bss, const u8 *addr)
 {
 	struct wlantest_sta *sta;
 
-	dl_list_for_each(sta, &bss->sta, struct wlantest_sta, list) {
+	for (sta = bss->sta_hash[WLANTEST_HASH(addr)]; sta; sta = sta->hnext) {
 		if (ether_addr_equal(sta->addr, addr))
 			return sta;
 	}
@@ -28,6 +28,27 @@ struct wlantest_sta * sta_find(struct wlantest_bss *bss, const u8 *addr)
 }
 
 
+static void sta_hash_add(struct wlantest_bss *bss, struct wlantest_sta *sta)
+{
+	sta->hnext = bss->sta_hash[WLANTEST_HASH(sta->addr)];
+	bss->sta_hash[WLANTEST_HASH(sta->addr)] = sta;
+}
+
+
+static void sta_hash_del(struct wlantest_bss *bss, struct wlantest_sta *sta)
+{
+	struct wlantest_sta **pos;
+
+	for (pos = &bss->sta_hash[WLANTEST_HASH(sta->addr)]; *pos;
+	     pos = &(*pos)->hnext) {
+		if (*pos == sta) {
+			*pos = sta->hnext;
+			return;
+		}
+	}
+}
+
+
 struct wlantest_sta * sta_find_mlo(struct wlantest *wt,
 				   struct wlantest_bss *bss, const u8 *addr)
 {
@@ -95,6 +116,7 @@ struct wlantest_sta * sta_get(struct wlantest_bss *bss, const u8 *addr)
 	sta->bss = bss;
 	os_memcpy(sta->addr, addr, ETH_ALEN);
 	dl_list_add(&bss->sta, &sta->list);
+	sta_hash_add(bss, sta);
 	wpa_printf(MSG_DEBUG, "Discovered new STA " MACSTR " in BSS " MACSTR
 		   " (MLD " MACSTR ")",
 		   MAC2STR(sta->addr),
@@ -105,12 +127,25 @@ struct wlantest_sta * sta_get(struct wlantest_bss *bss, const u8 *addr)
 
 void sta_deinit(struct wlantest_sta *sta)
 {
+	sta_hash_del(sta->bss, sta);
 	dl_list_del(&sta->list);
 	os_free(sta->assocreq_ies);
 	os_free(sta);
 }
 
 
+void sta_move(struct wlantest_sta *sta, struct wlantest_bss *bss,
+	      const u8 *addr)
+{
+	sta_hash_del(sta->bss, sta);
+	dl_list_del(&sta->list);
+	sta->bss = bss;
+	os_memcpy(sta->addr, addr, ETH_ALEN);
+	dl_list_add(&bss->sta, &sta->list);
+	sta_hash_add(bss, sta);
+}
+
+
 static void sta_update_assoc_ml(struct wlantest_sta *sta,
 				struct ieee802_11_elems *elems)
 {
@@ -45,14 +45,31 @@ struct wlantest_ptk {
 	size_t ptk_len;
 };
 
+/*
+ * Cache of the PTK that was found to match for a link when trying all known
+ * PTKs. Entries are indexed by the A1/A2 pair (either order) and KeyID.
+ */
+#define WLANTEST_PTK_CACHE_SIZE 256
+
+struct wlantest_ptk_cache {
+	u8 a1[ETH_ALEN];
+	u8 a2[ETH_ALEN];
+	int keyid;
+	struct wlantest_ptk *ptk;
+};
+
 struct wlantest_wep {
 	struct dl_list list;
 	size_t key_len;
 	u8 key[13];
 };
 
+#define WLANTEST_HASH_SIZE 256
+#define WLANTEST_HASH(addr) ((addr)[5])
+
 struct wlantest_sta {
 	struct dl_list list;
+	struct wlantest_sta *hnext; /* next entry in sta_hash of the BSS */
 	struct wlantest_bss *bss;
 	u8 addr[ETH_ALEN];
 	u8 mld_mac_addr[ETH_ALEN];
@@ -86,6 +103,8 @@ struct wlantest_sta {
 	u8 pmk_r1_name[WPA_PMK_NAME_LEN];
 	struct wpa_ptk ptk; /* Derived PTK */
 	int ptk_set;
+	struct wlantest_pmk last_pmk; /* PMK that was last used for PTK */
+	int last_pmk_set;
 	struct wpa_ptk tptk; /* Derived PTK during rekeying */
 	int tptk_set;
 	u8 rsc_tods[16 + 1][6];
@@ -142,6 +161,7 @@ struct wlantest_tdls {
 
 struct wlantest_bss {
 	struct dl_list list;
+	struct wlantest_bss *hnext; /* next entry in bss_hash */
 	u8 bssid[ETH_ALEN];
 	u8 mld_mac_addr[ETH_ALEN];
 	u8 link_id;
@@ -166,6 +186,7 @@ struct wlantest_bss {
 	int key_mgmt;
 	int rsn_capab;
 	struct dl_list sta; /* struct wlantest_sta */
+	struct wlantest_sta *sta_hash[WLANTEST_HASH_SIZE];
 	struct dl_list pmk; /* struct wlantest_pmk */
 	u8 gtk[4][32];
 	size_t gtk_len[4];
@@ -213,10 +234,12 @@ struct wlantest {
 
 	struct dl_list passphrase; /* struct wlantest_passphrase */
 	struct dl_list bss; /* struct wlantest_bss */
+	struct wlantest_bss *bss_hash[WLANTEST_HASH_SIZE];
 	struct dl_list secret; /* struct wlantest_radius_secret */
 	struct dl_list radius; /* struct wlantest_radius */
 	struct dl_list pmk; /* struct wlantest_pmk */
 	struct dl_list ptk; /* struct wlantest_ptk */
+	struct wlantest_ptk_cache ptk_cache[WLANTEST_PTK_CACHE_SIZE];
 	struct dl_list wep; /* struct wlantest_wep */
 
 	unsigned int rx_mgmt;
@@ -299,7 +322,7 @@ struct wlantest_bss * bss_find(struct wlantest *wt, const u8 *bssid);
 struct wlantest_bss * bss_find_mld(struct wlantest *wt, const u8 *mld_mac_addr,
 				   int link_id);
 struct wlantest_bss * bss_get(struct wlantest *wt, const u8 *bssid);
-void bss_deinit(struct wlantest_bss *bss);
+void bss_deinit(struct wlantest *wt, struct wlantest_bss *bss);
 void bss_update(struct wlantest *wt, struct wlantest_bss *bss,
 		struct ieee802_11_elems *elems, int beacon);
 void bss_flush(struct wlantest *wt);
@@ -313,6 +336,8 @@ struct wlantest_sta * sta_find_mlo(struct wlantest *wt,
 				   struct wlantest_bss *bss, const u8 *addr);
 struct wlantest_sta * sta_get(struct wlantest_bss *bss, const u8 *addr);
 void sta_deinit(struct wlantest_sta *sta);
+void sta_move(struct wlantest_sta *sta, struct wlantest_bss *bss,
+	      const u8 *addr);
 void sta_update_assoc(struct wlantest_sta *sta,
 		      struct ieee802_11_elems *elems);
 void sta_new_ptk(struct wlantest *wt, struct wlantest_sta *sta,
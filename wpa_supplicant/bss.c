@@ -21,6 +21,132 @@
 #include "bssid_ignore.h"
 #include "bss.h"
 
+/*
+ * Element index for the IE field of a BSS entry. Each element is indexed by
+ * its Element ID and, when applicable, also by the Element ID Extension or by
+ * the vendor type. The entries are sorted by the key and then by the offset so
+ * that a binary search finds the first matching element in the IE field.
+ */
+enum wpa_bss_ie_index_type {
+	BSS_IE_INDEX_EID,
+	BSS_IE_INDEX_EXT,
+	BSS_IE_INDEX_VENDOR,
+};
+
+struct wpa_bss_ie_index_entry {
+	u8 type; /* enum wpa_bss_ie_index_type */
+	u8 id; /* Element ID or Element ID Extension */
+	u16 pos; /* offset of the element in the IE field */
+	u32 vendor_type;
+};
+
+struct wpa_bss_ie_index {
+	size_t num;
+	struct wpa_bss_ie_index_entry entry[];
+};
+
+
+static int wpa_bss_ie_index_cmp(const void *a, const void *b)
+{
+	const struct wpa_bss_ie_index_entry *x = a, *y = b;
+
+	if (x->type != y->type)
+		return x->type < y->type ? -1 : 1;
+	if (x->id != y->id)
+		return x->id < y->id ? -1 : 1;
+	if (x->vendor_type != y->vendor_type)
+		return x->vendor_type < y->vendor_type ? -1 : 1;
+	if (x->pos != y->pos)
+		return x->pos < y->pos ? -1 : 1;
+	return 0;
+}
+
+
+static void wpa_bss_ie_index_add(struct wpa_bss_ie_index *idx, u8 type, u8 id,
+				 u32 vendor_type, size_t pos)
+{
+	struct wpa_bss_ie_index_entry *e = &idx->entry[idx->num++];
+
+	e->type = type;
+	e->id = id;
+	e->pos = pos;
+	e->vendor_type = vendor_type;
+}
+
+
+static void wpa_bss_build_ie_index(struct wpa_bss *bss)
+{
+	const u8 *ies = wpa_bss_ie_ptr(bss);
+	const struct element *elem;
+	struct wpa_bss_ie_index *idx;
+	size_t num = 0;
+
+	os_free(bss->ie_index);
+	bss->ie_index = NULL;
+
+	/* Fall back to parsing the IE field if offsets do not fit in u16 */
+	if (bss->ie_len > 0xffff)
+		return;
+
+	for_each_element(elem, ies, bss->ie_len) {
+		num++;
+		if ((elem->id == WLAN_EID_EXTENSION && elem->datalen >= 1) ||
+		    (elem->id == WLAN_EID_VENDOR_SPECIFIC && elem->datalen >= 4))
+			num++;
+	}
+
+	idx = os_malloc(sizeof(*idx) + num * sizeof(idx->entry[0]));
+	if (!idx)
+		return;
+	idx->num = 0;
+
+	for_each_element(elem, ies, bss->ie_len) {
+		size_t pos = (const u8 *) elem - ies;
+
+		wpa_bss_ie_index_add(idx, BSS_IE_INDEX_EID, elem->id, 0, pos);
+		if (elem->id == WLAN_EID_EXTENSION && elem->datalen >= 1)
+			wpa_bss_ie_index_add(idx, BSS_IE_INDEX_EXT,
+					     elem->data[0], 0, pos);
+		else if (elem->id == WLAN_EID_VENDOR_SPECIFIC &&
+			 elem->datalen >= 4)
+			wpa_bss_ie_index_add(idx, BSS_IE_INDEX_VENDOR, 0,
+					     WPA_GET_BE32(elem->data), pos);
+	}
+
+	qsort(idx->entry, idx->num, sizeof(idx->entry[0]),
+	      wpa_bss_ie_index_cmp);
+	bss->ie_index = idx;
+}
+
+
+static const struct wpa_bss_ie_index_entry *
+wpa_bss_ie_index_find(const struct wpa_bss_ie_index *idx, u8 type, u8 id,
+		      u32 vendor_type)
+{
+	struct wpa_bss_ie_index_entry key;
+	size_t lo = 0, hi = idx->num, mid;
+
+	key.type = type;
+	key.id = id;
+	key.pos = 0;
+	key.vendor_type = vendor_type;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (wpa_bss_ie_index_cmp(&idx->entry[mid], &key) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo < idx->num && idx->entry[lo].type == type &&
+	    idx->entry[lo].id == id &&
+	    idx->entry[lo].vendor_type == vendor_type)
+		return &idx->entry[lo];
+	return NULL;
+}
+
+
 static void wpa_bss_set_hessid(struct wpa_bss *bss)
 {
 #ifdef CONFIG_INTERWORKING
@@ -245,6 +371,7 @@ void wpa_bss_remove(struct wpa_supplicant *wpa_s, struct wpa_bss *bss,
 		wpa_ssid_txt(bss->ssid, bss->ssid_len), reason);
 	wpas_notify_bss_removed(wpa_s, bss->bssid, bss->id);
 	wpa_bss_anqp_free(bss->anqp);
+	os_free(bss->ie_index);
 	os_free(bss);
 }
 
@@ -543,6 +670,7 @@ static struct wpa_bss * wpa_bss_add(struct wpa_supplicant *wpa_s,
 	bss->ie_len = res->ie_len;
 	bss->beacon_ie_len = res->beacon_ie_len;
 	os_memcpy(bss->ies, res + 1, res->ie_len + res->beacon_ie_len);
+	wpa_bss_build_ie_index(bss);
 	wpa_bss_set_hessid(bss);
 
 	os_memset(bss->mld_addr, 0, ETH_ALEN);
@@ -833,6 +961,7 @@ wpa_bss_update(struct wpa_supplicant *wpa_s, struct wpa_bss *bss,
 	if (changes & WPA_BSS_IES_CHANGED_FLAG) {
 		const u8 *ml_ie, *mld_addr;
 
+		wpa_bss_build_ie_index(bss);
 		wpa_bss_set_hessid(bss);
 		os_memset(bss->mld_addr, 0, ETH_ALEN);
 		ml_ie = wpa_scan_get_ml_ie(res, MULTI_LINK_CONTROL_TYPE_BASIC);
@@ -1273,7 +1402,13 @@ struct wpa_bss * wpa_bss_get_id_range(struct wpa_supplicant *wpa_s,
  */
 const u8 * wpa_bss_get_ie(const struct wpa_bss *bss, u8 ie)
 {
-	return get_ie(wpa_bss_ie_ptr(bss), bss->ie_len, ie);
+	const struct wpa_bss_ie_index_entry *e;
+
+	if (!bss->ie_index)
+		return get_ie(wpa_bss_ie_ptr(bss), bss->ie_len, ie);
+
+	e = wpa_bss_ie_index_find(bss->ie_index, BSS_IE_INDEX_EID, ie, 0);
+	return e ? wpa_bss_ie_ptr(bss) + e->pos : NULL;
 }
 
 
@@ -1313,7 +1448,13 @@ const u8 * wpa_bss_get_ie_beacon(const struct wpa_bss *bss, u8 ie)
  */
 const u8 * wpa_bss_get_ie_ext(const struct wpa_bss *bss, u8 ext)
 {
-	return get_ie_ext(wpa_bss_ie_ptr(bss), bss->ie_len, ext);
+	const struct wpa_bss_ie_index_entry *e;
+
+	if (!bss->ie_index)
+		return get_ie_ext(wpa_bss_ie_ptr(bss), bss->ie_len, ext);
+
+	e = wpa_bss_ie_index_find(bss->ie_index, BSS_IE_INDEX_EXT, ext, 0);
+	return e ? wpa_bss_ie_ptr(bss) + e->pos : NULL;
 }
 
 
@@ -1333,6 +1474,14 @@ const u8 * wpa_bss_get_vendor_ie(const struct wpa_bss *bss, u32 vendor_type)
 
 	ies = wpa_bss_ie_ptr(bss);
 
+	if (bss->ie_index) {
+		const struct wpa_bss_ie_index_entry *e;
+
+		e = wpa_bss_ie_index_find(bss->ie_index, BSS_IE_INDEX_VENDOR,
+					  0, vendor_type);
+		return e ? ies + e->pos : NULL;
+	}
+
 	for_each_element_id(elem, WLAN_EID_VENDOR_SPECIFIC, ies, bss->ie_len) {
 		if (elem->datalen >= 4 &&
 		    vendor_type == WPA_GET_BE32(elem->data))
@@ -1401,6 +1550,22 @@ struct wpabuf * wpa_bss_get_vendor_ie_multi(const struct wpa_bss *bss,
 	pos = wpa_bss_ie_ptr(bss);
 	end = pos + bss->ie_len;
 
+	if (bss->ie_index) {
+		const struct wpa_bss_ie_index *idx = bss->ie_index;
+		const struct wpa_bss_ie_index_entry *e;
+
+		e = wpa_bss_ie_index_find(idx, BSS_IE_INDEX_VENDOR, 0,
+					  vendor_type);
+		while (e && e < &idx->entry[idx->num] &&
+		       e->type == BSS_IE_INDEX_VENDOR &&
+		       e->vendor_type == vendor_type) {
+			wpabuf_put_data(buf, pos + e->pos + 2 + 4,
+					pos[e->pos + 1] - 4);
+			e++;
+		}
+		goto out;
+	}
+
 	while (end - pos > 1) {
 		u8 ie, len;
 
@@ -1415,6 +1580,7 @@ struct wpabuf * wpa_bss_get_vendor_ie_multi(const struct wpa_bss *bss,
 		pos += len;
 	}
 
+out:
 	if (wpabuf_len(buf) == 0) {
 		wpabuf_free(buf);
 		buf = NULL;
@@ -67,6 +67,8 @@ struct wpa_bss_anqp {
 #endif /* CONFIG_HS20 */
 };
 
+struct wpa_bss_ie_index;
+
 /**
  * struct wpa_bss - BSS table
  *
@@ -122,6 +124,8 @@ struct wpa_bss {
 	struct wpa_bss_anqp *anqp;
 	/** Length of the following IE field in octets (from Probe Response) */
 	size_t ie_len;
+	/** Index of the elements in the IE field (not the Beacon IE field) */
+	struct wpa_bss_ie_index *ie_index;
 	/** Length of the following Beacon IE field in octets */
 	size_t beacon_ie_len;
 	/** MLD address of the AP */
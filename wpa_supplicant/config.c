@@ -61,6 +61,91 @@ struct parse_data {
 };
 
 
+/*
+ * Hash index for the configuration field name tables (ssid_fields[] and
+ * global_fields[]) to avoid a linear search over all the field names whenever
+ * a parameter is set or read. The index is built on first use and each entry
+ * is the index of the field in the table + 1 (0 marks an unused entry).
+ */
+#define CONFIG_FIELD_INDEX_SIZE 1024
+
+struct config_field_index {
+	bool initialized;
+	u16 entry[CONFIG_FIELD_INDEX_SIZE];
+};
+
+
+static unsigned int config_field_hash(const char *name, size_t len)
+{
+	u32 hash = 2166136261U;
+
+	/* FNV-1a */
+	while (len--) {
+		hash ^= (u8) *name++;
+		hash *= 16777619;
+	}
+
+	return hash & (CONFIG_FIELD_INDEX_SIZE - 1);
+}
+
+
+static const char * config_field_name(const void *fields, size_t field_size,
+				      size_t i)
+{
+	/* The name is the first member of both field table structures */
+	return *(char * const *) ((const u8 *) fields + i * field_size);
+}
+
+
+static void config_field_index_init(struct config_field_index *idx,
+				    const void *fields, size_t field_size,
+				    size_t num_fields)
+{
+	size_t i, j;
+	unsigned int pos;
+	const char *name;
+
+	for (i = 0; i < num_fields; i++) {
+		name = config_field_name(fields, field_size, i);
+		pos = config_field_hash(name, os_strlen(name));
+		for (j = 0; j < CONFIG_FIELD_INDEX_SIZE; j++) {
+			if (!idx->entry[pos]) {
+				idx->entry[pos] = i + 1;
+				break;
+			}
+			pos = (pos + 1) & (CONFIG_FIELD_INDEX_SIZE - 1);
+		}
+	}
+	idx->initialized = true;
+}
+
+
+/* Returns the index of the field in the table or -1 if not found */
+static int config_field_index_find(struct config_field_index *idx,
+				   const void *fields, size_t field_size,
+				   size_t num_fields, const char *name,
+				   size_t len)
+{
+	size_t j;
+	unsigned int pos;
+	const char *fname;
+
+	if (!idx->initialized)
+		config_field_index_init(idx, fields, field_size, num_fields);
+
+	pos = config_field_hash(name, len);
+	for (j = 0; j < CONFIG_FIELD_INDEX_SIZE && idx->entry[pos]; j++) {
+		fname = config_field_name(fields, field_size,
+					  idx->entry[pos] - 1);
+		if (os_strncmp(fname, name, len) == 0 && fname[len] == '\0')
+			return idx->entry[pos] - 1;
+		pos = (pos + 1) & (CONFIG_FIELD_INDEX_SIZE - 1);
+	}
+
+	return -1;
+}
+
+
 static int wpa_config_parse_str(const struct parse_data *data,
 				struct wpa_ssid *ssid,
 				int line, const char *value)
@@ -2777,6 +2862,19 @@ static const struct parse_data ssid_fields[] = {
 #undef FUNC_KEY
 #define NUM_SSID_FIELDS ARRAY_SIZE(ssid_fields)
 
+static struct config_field_index ssid_field_index;
+
+
+static const struct parse_data * ssid_field_get(const char *var)
+{
+	int i;
+
+	i = config_field_index_find(&ssid_field_index, ssid_fields,
+				    sizeof(ssid_fields[0]), NUM_SSID_FIELDS,
+				    var, os_strlen(var));
+	return i < 0 ? NULL : &ssid_fields[i];
+}
+
 
 /**
  * wpa_config_add_prio_network - Add a network to priority lists
@@ -3322,17 +3420,14 @@ static bool removed_field(const char *field)
 int wpa_config_set(struct wpa_ssid *ssid, const char *var, const char *value,
 		   int line)
 {
-	size_t i;
+	const struct parse_data *field;
 	int ret = 0;
 
 	if (ssid == NULL || var == NULL || value == NULL)
 		return -1;
 
-	for (i = 0; i < NUM_SSID_FIELDS; i++) {
-		const struct parse_data *field = &ssid_fields[i];
-		if (os_strcmp(var, field->name) != 0)
-			continue;
-
+	field = ssid_field_get(var);
+	if (field) {
 		ret = field->parser(field, ssid, line, value);
 		if (ret < 0) {
 			if (line) {
@@ -3350,9 +3445,7 @@ int wpa_config_set(struct wpa_ssid *ssid, const char *var, const char *value,
 			ssid->pt = NULL;
 		}
 #endif /* CONFIG_SAE */
-		break;
-	}
-	if (i == NUM_SSID_FIELDS) {
+	} else {
 		if (removed_field(var)) {
 			wpa_printf(MSG_INFO,
 				   "Line %d: Ignore removed configuration field '%s'",
@@ -3472,29 +3565,26 @@ err:
  */
 char * wpa_config_get(struct wpa_ssid *ssid, const char *var)
 {
-	size_t i;
+	const struct parse_data *field;
+	char *ret;
 
 	if (ssid == NULL || var == NULL)
 		return NULL;
 
-	for (i = 0; i < NUM_SSID_FIELDS; i++) {
-		const struct parse_data *field = &ssid_fields[i];
-		if (os_strcmp(var, field->name) == 0) {
-			char *ret = field->writer(field, ssid);
-
-			if (ret && has_newline(ret)) {
-				wpa_printf(MSG_ERROR,
-					   "Found newline in value for %s; not returning it",
-					   var);
-				os_free(ret);
-				ret = NULL;
-			}
+	field = ssid_field_get(var);
+	if (!field)
+		return NULL;
 
-			return ret;
-		}
+	ret = field->writer(field, ssid);
+	if (ret && has_newline(ret)) {
+		wpa_printf(MSG_ERROR,
+			   "Found newline in value for %s; not returning it",
+			   var);
+		os_free(ret);
+		ret = NULL;
 	}
 
-	return NULL;
+	return ret;
 }
 
 
@@ -3516,32 +3606,30 @@ char * wpa_config_get(struct wpa_ssid *ssid, const char *var)
  */
 char * wpa_config_get_no_key(struct wpa_ssid *ssid, const char *var)
 {
-	size_t i;
+	const struct parse_data *field;
+	char *res;
 
 	if (ssid == NULL || var == NULL)
 		return NULL;
 
-	for (i = 0; i < NUM_SSID_FIELDS; i++) {
-		const struct parse_data *field = &ssid_fields[i];
-		if (os_strcmp(var, field->name) == 0) {
-			char *res = field->writer(field, ssid);
-			if (field->key_data) {
-				if (res && res[0]) {
-					wpa_printf(MSG_DEBUG, "Do not allow "
-						   "key_data field to be "
-						   "exposed");
-					str_clear_free(res);
-					return os_strdup("*");
-				}
+	field = ssid_field_get(var);
+	if (!field)
+		return NULL;
 
-				os_free(res);
-				return NULL;
-			}
-			return res;
+	res = field->writer(field, ssid);
+	if (field->key_data) {
+		if (res && res[0]) {
+			wpa_printf(MSG_DEBUG, "Do not allow key_data field to be "
+				   "exposed");
+			str_clear_free(res);
+			return os_strdup("*");
 		}
+
+		os_free(res);
+		return NULL;
 	}
 
-	return NULL;
+	return res;
 }
 #endif /* NO_CONFIG_WRITE */
 
@@ -5612,6 +5700,20 @@ static const struct global_parse_data global_fields[] = {
 #undef IPV4
 #define NUM_GLOBAL_FIELDS ARRAY_SIZE(global_fields)
 
+static struct config_field_index global_field_index;
+
+
+static const struct global_parse_data * global_field_get(const char *name,
+							 size_t len)
+{
+	int i;
+
+	i = config_field_index_find(&global_field_index, global_fields,
+				    sizeof(global_fields[0]), NUM_GLOBAL_FIELDS,
+				    name, len);
+	return i < 0 ? NULL : &global_fields[i];
+}
+
 
 int wpa_config_dump_values(struct wpa_config *config, char *buf, size_t buflen)
 {
@@ -5640,20 +5742,12 @@ int wpa_config_dump_values(struct wpa_config *config, char *buf, size_t buflen)
 int wpa_config_get_value(const char *name, struct wpa_config *config,
 			 char *buf, size_t buflen)
 {
-	size_t i;
+	const struct global_parse_data *field;
 
-	for (i = 0; i < NUM_GLOBAL_FIELDS; i++) {
-		const struct global_parse_data *field = &global_fields[i];
-
-		if (os_strcmp(name, field->name) != 0)
-			continue;
-		if (!field->get)
-			break;
-		return field->get(name, config, (long) field->param1,
-				  buf, buflen, 0);
-	}
-
-	return -1;
+	field = global_field_get(name, os_strlen(name));
+	if (!field || !field->get)
+		return -1;
+	return field->get(name, config, (long) field->param1, buf, buflen, 0);
 }
 
 
@@ -5689,30 +5783,27 @@ const char * wpa_config_get_global_field_name(unsigned int i, int *no_var)
  */
 int wpa_config_process_global(struct wpa_config *config, char *pos, int line)
 {
-	size_t i;
+	const struct global_parse_data *field = NULL;
+	const char *eq;
 	int ret = 0;
 
-	for (i = 0; i < NUM_GLOBAL_FIELDS; i++) {
-		const struct global_parse_data *field = &global_fields[i];
-		size_t flen = os_strlen(field->name);
-		if (os_strncmp(pos, field->name, flen) != 0 ||
-		    pos[flen] != '=')
-			continue;
-
-		ret = field->parser(field, config, line, pos + flen + 1);
+	eq = os_strchr(pos, '=');
+	if (eq)
+		field = global_field_get(pos, eq - pos);
+	if (field) {
+		ret = field->parser(field, config, line, eq + 1);
 		if (ret < 0) {
 			wpa_printf(MSG_ERROR, "Line %d: failed to "
 				   "parse '%s'.", line, pos);
 			ret = -1;
 		}
-		if (ret == 1)
-			break;
-		if (field->changed_flag == CFG_CHANGED_NFC_PASSWORD_TOKEN)
-			config->wps_nfc_pw_from_config = 1;
-		config->changed_parameters |= field->changed_flag;
-		break;
-	}
-	if (i == NUM_GLOBAL_FIELDS) {
+		if (ret != 1) {
+			if (field->changed_flag ==
+			    CFG_CHANGED_NFC_PASSWORD_TOKEN)
+				config->wps_nfc_pw_from_config = 1;
+			config->changed_parameters |= field->changed_flag;
+		}
+	} else {
 #ifdef CONFIG_AP
 		if (os_strncmp(pos, "tx_queue_", 9) == 0) {
 			char *tmp = os_strchr(pos, '=');
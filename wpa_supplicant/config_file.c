@@ -1635,6 +1635,27 @@ static void wpa_config_write_global(FILE *f, struct wpa_config *config)
 	}
 }
 
+
+static bool wpa_config_file_unchanged(const char *tmp_name,
+				      const char *orig_name)
+{
+	char *new_buf, *old_buf;
+	size_t new_len, old_len;
+	bool unchanged = false;
+
+	new_buf = os_readfile(tmp_name, &new_len);
+	if (!new_buf)
+		return false;
+	old_buf = os_readfile(orig_name, &old_len);
+	if (old_buf && new_len == old_len &&
+	    os_memcmp(new_buf, old_buf, new_len) == 0)
+		unchanged = true;
+	bin_clear_free(new_buf, new_len);
+	if (old_buf)
+		bin_clear_free(old_buf, old_len);
+	return unchanged;
+}
+
 #endif /* CONFIG_NO_CONFIG_WRITE */
 
 
@@ -1706,6 +1727,19 @@ int wpa_config_write(const char *name, struct wpa_config *config)
 	}
 #endif /* CONFIG_NO_CONFIG_BLOBS */
 
+	if (tmp_name && ret == 0 && fflush(f) == 0 &&
+	    wpa_config_file_unchanged(tmp_name, orig_name)) {
+		/* Avoid the sync and rename (and the resulting flash writes)
+		 * when the configuration did not change. */
+		fclose(f);
+		remove(tmp_name);
+		os_free(tmp_name);
+		wpa_printf(MSG_DEBUG,
+			   "Configuration file '%s' unchanged - not updated",
+			   orig_name);
+		return 0;
+	}
+
 	os_fdatasync(f);
 
 	fclose(f);
@@ -2240,6 +2240,30 @@ static int wpa_supplicant_ctrl_iface_ctrl_rsp(struct wpa_supplicant *wpa_s,
 }
 
 
+static int wpa_supplicant_ctrl_iface_l2_mib(struct wpa_supplicant *wpa_s,
+					    char *buf, size_t buflen)
+{
+	struct l2_packet_stats stats;
+	int ret;
+
+	if (!wpa_s->l2 || l2_packet_get_stats(wpa_s->l2, &stats) < 0)
+		return 0;
+
+	ret = os_snprintf(buf, buflen,
+			  "l2RxPackets=%lu\n"
+			  "l2RxBytes=%lu\n"
+			  "l2RxDropped=%lu\n"
+			  "l2TxPackets=%lu\n"
+			  "l2TxBytes=%lu\n"
+			  "l2TxErrors=%lu\n",
+			  stats.rx_packets, stats.rx_bytes, stats.rx_dropped,
+			  stats.tx_packets, stats.tx_bytes, stats.tx_errors);
+	if (os_snprintf_error(buflen, ret))
+		return 0;
+	return ret;
+}
+
+
 static int wpa_supplicant_ctrl_iface_status(struct wpa_supplicant *wpa_s,
 					    const char *params,
 					    char *buf, size_t buflen)
@@ -12703,6 +12727,9 @@ char * wpa_supplicant_ctrl_iface_process(struct wpa_supplicant *wpa_s,
 				wpa_s->kay, reply + reply_len,
 				reply_size - reply_len);
 #endif /* CONFIG_MACSEC */
+			reply_len += wpa_supplicant_ctrl_iface_l2_mib(
+				wpa_s, reply + reply_len,
+				reply_size - reply_len);
 		}
 	} else if (os_strncmp(buf, "STATUS", 6) == 0) {
 		reply_len = wpa_supplicant_ctrl_iface_status(
@@ -498,6 +498,32 @@ static void wpa_supplicant_ctrl_iface_msg_cb(void *ctx, int level,
 }
 
 
+static int wpa_supplicant_ctrl_iface_msg_check(void *ctx, int level,
+					       enum wpa_msg_type type)
+{
+	struct wpa_supplicant *wpa_s = ctx;
+	struct ctrl_iface_priv *priv;
+	struct ctrl_iface_global_priv *gpriv;
+
+	if (wpa_s == NULL)
+		return 0;
+
+	gpriv = wpa_s->global->ctrl_iface;
+	if (type != WPA_MSG_NO_GLOBAL && gpriv &&
+	    (!dl_list_empty(&gpriv->msg_queue) ||
+	     ctrl_iface_monitored(&gpriv->ctrl_dst, level)))
+		return 1;
+
+	priv = wpa_s->ctrl_iface;
+	if (type != WPA_MSG_ONLY_GLOBAL && priv &&
+	    (!dl_list_empty(&priv->msg_queue) ||
+	     ctrl_iface_monitored(&priv->ctrl_dst, level)))
+		return 1;
+
+	return 0;
+}
+
+
 static int wpas_ctrl_iface_open_sock(struct wpa_supplicant *wpa_s,
 				     struct ctrl_iface_priv *priv)
 {
@@ -685,6 +711,7 @@ havesock:
 	eloop_register_read_sock(priv->sock, wpa_supplicant_ctrl_iface_receive,
 				 wpa_s, priv);
 	wpa_msg_register_cb(wpa_supplicant_ctrl_iface_msg_cb);
+	wpa_msg_register_check_cb(wpa_supplicant_ctrl_iface_msg_check);
 
 	os_free(buf);
 	return 0;
@@ -1375,6 +1402,7 @@ wpa_supplicant_global_ctrl_iface_init(struct wpa_global *global)
 	}
 
 	wpa_msg_register_cb(wpa_supplicant_ctrl_iface_msg_cb);
+	wpa_msg_register_check_cb(wpa_supplicant_ctrl_iface_msg_check);
 
 	return priv;
 }
@@ -1257,10 +1257,8 @@ static int wpas_p2p_store_persistent_group(struct wpa_supplicant *wpa_s,
 		changed = 1;
 	}
 
-	if (changed && wpa_s->conf->update_config &&
-	    wpa_config_write(wpa_s->confname, wpa_s->conf)) {
-		wpa_printf(MSG_DEBUG, "P2P: Failed to update configuration");
-	}
+	if (changed)
+		wpas_config_write_deferred(wpa_s);
 
 	return s->id;
 }
@@ -1339,9 +1337,7 @@ static void wpas_p2p_add_persistent_group_client(struct wpa_supplicant *wpa_s,
 			  0xff, ETH_ALEN);
 	}
 
-	if (p2p_wpa_s->conf->update_config &&
-	    wpa_config_write(p2p_wpa_s->confname, p2p_wpa_s->conf))
-		wpa_printf(MSG_DEBUG, "P2P: Failed to update configuration");
+	wpas_config_write_deferred(p2p_wpa_s);
 }
 
 
@@ -2060,11 +2056,7 @@ static void p2p_go_save_group_common_freqs(struct wpa_supplicant *wpa_s,
 
 static void p2p_config_write(struct wpa_supplicant *wpa_s)
 {
-#ifndef CONFIG_NO_CONFIG_WRITE
-	if (wpa_s->p2pdev->conf->update_config &&
-	    wpa_config_write(wpa_s->p2pdev->confname, wpa_s->p2pdev->conf))
-		wpa_printf(MSG_DEBUG, "P2P: Failed to update configuration");
-#endif /* CONFIG_NO_CONFIG_WRITE */
+	wpas_config_write_deferred(wpa_s->p2pdev);
 }
 
 
@@ -3728,9 +3720,7 @@ static void wpas_remove_persistent_peer(struct wpa_supplicant *wpa_s,
 		   ssid->p2p_client_list + (i + 1) * 2 * ETH_ALEN,
 		   (ssid->num_p2p_clients - i - 1) * 2 * ETH_ALEN);
 	ssid->num_p2p_clients--;
-	if (p2p_wpa_s->conf->update_config &&
-	    wpa_config_write(p2p_wpa_s->confname, p2p_wpa_s->conf))
-		wpa_printf(MSG_DEBUG, "P2P: Failed to update configuration");
+	wpas_config_write_deferred(p2p_wpa_s);
 }
 
 
@@ -9445,9 +9435,7 @@ void wpas_p2p_new_psk_cb(struct wpa_supplicant *wpa_s, const u8 *mac_addr,
 	}
 	dl_list_add(&persistent->psk_list, &p->list);
 
-	if (wpa_s->p2pdev->conf->update_config &&
-	    wpa_config_write(wpa_s->p2pdev->confname, wpa_s->p2pdev->conf))
-		wpa_printf(MSG_DEBUG, "P2P: Failed to update configuration");
+	wpas_config_write_deferred(wpa_s->p2pdev);
 }
 
 
@@ -9458,10 +9446,8 @@ static void wpas_p2p_remove_psk(struct wpa_supplicant *wpa_s,
 	int res;
 
 	res = wpas_p2p_remove_psk_entry(wpa_s, s, addr, iface_addr);
-	if (res > 0 && wpa_s->conf->update_config &&
-	    wpa_config_write(wpa_s->confname, wpa_s->conf))
-		wpa_dbg(wpa_s, MSG_DEBUG,
-			"P2P: Failed to update configuration");
+	if (res > 0)
+		wpas_config_write_deferred(wpa_s);
 }
 
 
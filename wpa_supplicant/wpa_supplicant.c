@@ -1255,6 +1255,59 @@ void wpa_supplicant_clear_status(struct wpa_supplicant *wpa_s)
 }
 
 
+/* Time (in seconds) during which configuration file updates are combined */
+#define WPAS_CONFIG_WRITE_DELAY 1
+
+#ifndef CONFIG_NO_CONFIG_WRITE
+static void wpas_config_write_timeout(void *eloop_ctx, void *timeout_ctx)
+{
+	struct wpa_supplicant *wpa_s = eloop_ctx;
+
+	if (wpa_s->conf && wpa_s->conf->update_config &&
+	    wpa_config_write(wpa_s->confname, wpa_s->conf))
+		wpa_printf(MSG_DEBUG, "Failed to update configuration");
+}
+#endif /* CONFIG_NO_CONFIG_WRITE */
+
+
+/**
+ * wpas_config_write_deferred - Request a configuration file update
+ * @wpa_s: Pointer to wpa_supplicant data for the configuration to write
+ *
+ * This function can be used instead of calling wpa_config_write() directly
+ * when the caller does not need to know the result of the write operation.
+ * The configuration file is written after a short delay and all requests
+ * made during that time are combined into a single write. Nothing is done if
+ * update_config=0.
+ */
+void wpas_config_write_deferred(struct wpa_supplicant *wpa_s)
+{
+#ifndef CONFIG_NO_CONFIG_WRITE
+	if (!wpa_s->conf || !wpa_s->conf->update_config ||
+	    eloop_is_timeout_registered(wpas_config_write_timeout, wpa_s, NULL))
+		return;
+	eloop_register_timeout(WPAS_CONFIG_WRITE_DELAY, 0,
+			       wpas_config_write_timeout, wpa_s, NULL);
+#endif /* CONFIG_NO_CONFIG_WRITE */
+}
+
+
+/**
+ * wpas_config_write_flush - Write pending configuration file update
+ * @wpa_s: Pointer to wpa_supplicant data
+ *
+ * This function completes a configuration file write that was requested with
+ * wpas_config_write_deferred(), if any, without waiting for the delay.
+ */
+void wpas_config_write_flush(struct wpa_supplicant *wpa_s)
+{
+#ifndef CONFIG_NO_CONFIG_WRITE
+	if (eloop_cancel_timeout(wpas_config_write_timeout, wpa_s, NULL) > 0)
+		wpas_config_write_timeout(wpa_s, NULL);
+#endif /* CONFIG_NO_CONFIG_WRITE */
+}
+
+
 /**
  * wpa_supplicant_reload_configuration - Reload configuration data
  * @wpa_s: Pointer to wpa_supplicant data
@@ -1274,6 +1327,7 @@ int wpa_supplicant_reload_configuration(struct wpa_supplicant *wpa_s)
 
 	if (wpa_s->confname == NULL)
 		return -1;
+	wpas_config_write_flush(wpa_s);
 	conf = wpa_config_read(wpa_s->confname, NULL, false);
 	if (conf == NULL) {
 		wpa_msg(wpa_s, MSG_ERROR, "Failed to parse the configuration "
@@ -7808,6 +7862,7 @@ static void wpa_supplicant_deinit_iface(struct wpa_supplicant *wpa_s,
 #endif /* CONFIG_MESH */
 
 	if (wpa_s->conf != NULL) {
+		wpas_config_write_flush(wpa_s);
 		wpa_config_free(wpa_s->conf);
 		wpa_s->conf = NULL;
 	}